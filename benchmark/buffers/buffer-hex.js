@@ -3,11 +3,12 @@
 const common = require('../common.js');
 
 const bench = common.createBenchmark(main, {
-  len: [64, 1024],
-  n: [1e6]
+  len: [64, 1024, 65536],
+  op: ['decode', 'encode'],
+  n: [1e5]
 });
 
-function main({ len, n }) {
+function main({ len, op, n }) {
   const buf = Buffer.alloc(len);
 
   for (let i = 0; i < buf.length; i++)
@@ -15,10 +16,15 @@ function main({ len, n }) {
 
   const hex = buf.toString('hex');
 
-  bench.start();
-
-  for (let i = 0; i < n; i += 1)
-    Buffer.from(hex, 'hex');
-
-  bench.end(n);
+  if (op === 'decode') {
+    bench.start();
+    for (let i = 0; i < n; i += 1)
+      Buffer.from(hex, 'hex');
+    bench.end(n);
+  } else {
+    bench.start();
+    for (let i = 0; i < n; i += 1)
+      buf.toString('hex');
+    bench.end(n);
+  }
 }
@@ -0,0 +1,19 @@
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  method: ['toString', 'toExternalString'],
+  encoding: ['latin1', 'ascii', 'utf8'],
+  len: [64 * 1024, 4 * 1024 * 1024],
+  n: [2e3]
+});
+
+function main({ method, encoding, len, n }) {
+  const buf = Buffer.alloc(len, 'log line\n');
+
+  bench.start();
+  for (let i = 0; i < n; i += 1)
+    buf[method](encoding);
+  bench.end(n);
+}
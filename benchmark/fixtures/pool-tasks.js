@@ -0,0 +1,10 @@
+'use strict';
+
+exports.echo = (value) => value;
+
+exports.spin = (iterations) => {
+  let sum = 0;
+  for (let i = 0; i < iterations; i++)
+    sum += i % 7;
+  return sum;
+};
@@ -0,0 +1,45 @@
+'use strict';
+
+// Compares handling small responses through the http-compatible API with
+// handling them through the core stream API.
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  api: ['compat', 'core'],
+  size: [16, 1024, 16 * 1024],
+  requests: [10000],
+  streams: [1, 100],
+  clients: [2],
+  benchmarker: ['test-double-http2'],
+  duration: 5
+}, { flags: ['--no-warnings'] });
+
+function main({ api, size, requests, streams, clients, duration }) {
+  const http2 = require('http2');
+  const server = http2.createServer();
+  const body = 'x'.repeat(size);
+
+  if (api === 'compat') {
+    server.on('request', (req, res) => {
+      res.setHeader('content-type', 'text/plain');
+      res.end(body);
+    });
+  } else {
+    server.on('stream', (stream) => {
+      stream.respond({ 'content-type': 'text/plain' });
+      stream.end(body);
+    });
+  }
+
+  server.listen(common.PORT, () => {
+    bench.http({
+      path: '/',
+      requests,
+      maxConcurrentStreams: streams,
+      clients,
+      threads: clients,
+      duration
+    }, () => { server.close(); });
+  });
+}
@@ -0,0 +1,57 @@
+// Measure HTTP/2 download throughput of large responses, which exercises
+// the DATA frame write path of the server.
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  len: [64 * 1024, 1024 * 1024, 16 * 1024 * 1024],
+  maxFrameSize: [16384, 256 * 1024],
+  dur: [5],
+}, { flags: ['--no-warnings'] });
+
+function main({ len, maxFrameSize, dur }) {
+  const http2 = require('http2');
+  const chunk = Buffer.alloc(len, 'x');
+  const settings = {
+    maxFrameSize,
+    initialWindowSize: 8 * 1024 * 1024,
+  };
+
+  const server = http2.createServer({ settings });
+  server.on('stream', (stream) => {
+    stream.respond();
+    stream.end(chunk);
+  });
+
+  server.listen(common.PORT, () => {
+    const client = http2.connect(`http://localhost:${common.PORT}`,
+                                 { settings });
+    let received = 0;
+    let done = false;
+
+    client.on('connect', () => {
+      // Also open up the connection-level window.
+      client.setLocalWindowSize(32 * 1024 * 1024);
+      bench.start();
+      request();
+
+      setTimeout(() => {
+        done = true;
+        const gbits = (received * 8) / (1024 * 1024 * 1024);
+        bench.end(gbits);
+        client.destroy();
+        server.close();
+      }, dur * 1000);
+    });
+
+    function request() {
+      const req = client.request({ ':path': '/' });
+      req.on('data', (data) => received += data.length);
+      req.on('end', () => {
+        if (!done) request();
+      });
+      req.on('error', () => {});
+    }
+  });
+}
@@ -0,0 +1,29 @@
+'use strict';
+
+const common = require('../common.js');
+const { Readable } = require('stream');
+
+// Converts the chunks buffered in a stream when setEncoding() is called. The
+// chunks deliberately split multi-byte characters.
+const bench = common.createBenchmark(main, {
+  encoding: ['utf8', 'base64', 'utf16le'],
+  chunks: [16, 256],
+  chunkLen: [16, 1024],
+  n: [2e4]
+});
+
+function main({ encoding, chunks, chunkLen, n }) {
+  const data = Buffer.from('a€bcdé𝌆'.repeat(chunks * chunkLen));
+  const list = [];
+  for (let i = 0; i < chunks; i++)
+    list.push(data.slice(i * chunkLen, (i + 1) * chunkLen));
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const readable = new Readable({ read() {} });
+    for (let j = 0; j < list.length; j++)
+      readable.push(list[j]);
+    readable.setEncoding(encoding);
+  }
+  bench.end(n);
+}
@@ -0,0 +1,66 @@
+'use strict';
+const common = require('../common.js');
+const { RouteTable } = require('url');
+const assert = require('assert');
+
+const bench = common.createBenchmark(main, {
+  routes: [10, 100, 500],
+  method: ['RouteTable', 'RegExp'],
+  n: [1e6]
+});
+
+function createPatterns(routes) {
+  const patterns = [];
+  for (let i = 0; patterns.length < routes; i++) {
+    patterns.push(`/api/v1/resource${i}`);
+    patterns.push(`/api/v1/resource${i}/:id`);
+    patterns.push(`/api/v1/resource${i}/:id/items/:itemId`);
+    patterns.push(`/static/group${i}/*`);
+  }
+  return patterns.slice(0, routes);
+}
+
+function createPath(pattern, i) {
+  return pattern.replace(/:\w+|\*/g, `value${i}`);
+}
+
+// The usual way of matching routes in JS: one RegExp per pattern, which are
+// tried in order.
+function createRegExpRouter(patterns) {
+  const routes = patterns.map((pattern, id) => {
+    const names = [];
+    const source = pattern.replace(/:(\w+)|\*/g, (match, name) => {
+      names.push(name === undefined ? '0' : name);
+      return name === undefined ? '(.*)' : '([^/]+)';
+    });
+    return { id, names, regexp: new RegExp(`^${source}$`) };
+  });
+  return {
+    match(path) {
+      for (const { id, names, regexp } of routes) {
+        const result = regexp.exec(path);
+        if (result !== null) {
+          const params = {};
+          for (let i = 0; i < names.length; i++)
+            params[names[i]] = result[i + 1];
+          return { id, params };
+        }
+      }
+      return null;
+    }
+  };
+}
+
+function main({ routes, method, n }) {
+  const patterns = createPatterns(routes);
+  const paths = patterns.map(createPath);
+  const router = method === 'RouteTable' ?
+    new RouteTable(patterns) : createRegExpRouter(patterns);
+
+  let noDead;  // Avoid dead code elimination.
+  bench.start();
+  for (let i = 0; i < n; i++)
+    noDead = router.match(paths[i % paths.length]);
+  bench.end(n);
+  assert.ok(noDead);
+}
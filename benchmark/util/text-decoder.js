@@ -0,0 +1,27 @@
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  type: ['ascii', 'one-byte', 'two-byte'],
+  stream: [0, 1],
+  len: [256, 1024 * 16],
+  n: [5e5]
+});
+
+const chars = {
+  'ascii': 'a',
+  'one-byte': 'é',
+  'two-byte': '€'
+};
+
+function main({ n, type, stream, len }) {
+  const data = Buffer.from(chars[type].repeat(len)).slice(0, len);
+  const decoder = new TextDecoder();
+  const options = { stream: !!stream };
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    decoder.decode(data, options);
+  bench.end(n);
+}
@@ -4,11 +4,13 @@ const common = require('../common.js');
 const { MessageChannel } = require('worker_threads');
 const bench = common.createBenchmark(main, {
   payload: ['string', 'object'],
+  batch: [1, 100],
   n: [1e6]
 });
 
 function main(conf) {
   const n = conf.n;
+  const batch = conf.batch;
   let payload;
 
   switch (conf.payload) {
@@ -29,7 +31,7 @@ function main(conf) {
     if (messages++ === n) {
       bench.end(n);
       port1.close();
-    } else {
+    } else if (messages % batch === 0) {
       write();
     }
   };
@@ -37,6 +39,7 @@ function main(conf) {
   write();
 
   function write() {
-    port1.postMessage(payload);
+    for (let i = 0; i < batch; i++)
+      port1.postMessage(payload);
   }
 }
@@ -0,0 +1,47 @@
+'use strict';
+
+const common = require('../common.js');
+const { Pool } = require('worker_threads');
+const path = require('path');
+const bench = common.createBenchmark(main, {
+  threads: [1, 4],
+  task: ['echo', 'spin'],
+  concurrency: [1, 64],
+  n: [1e4]
+});
+
+const tasksPath = path.resolve(__dirname, '..', 'fixtures', 'pool-tasks.js');
+
+function main({ n, threads, task, concurrency }) {
+  const pool = new Pool(tasksPath, {
+    minThreads: threads,
+    maxThreads: threads
+  });
+  const arg = task === 'spin' ? 1e4 : { action: 'pewpewpew', powerLevel: 9001 };
+  let submitted = 0;
+  let completed = 0;
+
+  function submit() {
+    submitted++;
+    pool.run(arg, { name: task }).then(onDone);
+  }
+
+  function onDone() {
+    if (++completed === n) {
+      bench.end(n);
+      pool.destroy();
+    } else if (submitted < n) {
+      submit();
+    }
+  }
+
+  // Run one task per thread first, so that thread startup is not measured.
+  const warmup = [];
+  for (let i = 0; i < threads; i++)
+    warmup.push(pool.run(arg, { name: task }));
+  Promise.all(warmup).then(() => {
+    bench.start();
+    for (let i = 0; i < concurrency && submitted < n; i++)
+      submit();
+  });
+}
@@ -0,0 +1,60 @@
+'use strict';
+
+const common = require('../common.js');
+const { Worker, createRingChannel } = require('worker_threads');
+const bench = common.createBenchmark(main, {
+  method: ['ringchannel', 'messageport'],
+  len: [64, 1024],
+  n: [1e5]
+});
+
+// The worker produces `n` records of `len` bytes each once it is told to
+// start, and the main thread consumes them.
+const workerSource = `
+const { parentPort, workerData } = require('worker_threads');
+const { n, len, channel } = workerData;
+const record = Buffer.alloc(len, 'x');
+parentPort.once('message', () => {
+  for (let i = 0; i < n; i++) {
+    if (channel)
+      channel.writeSync(record);
+    else
+      parentPort.postMessage(record);
+  }
+  if (channel)
+    channel.close();
+});
+`;
+
+function main({ method, len, n }) {
+  const channel = method === 'ringchannel' ?
+    createRingChannel({ size: 1024 * 1024 }) : undefined;
+  const worker = new Worker(workerSource, {
+    eval: true,
+    workerData: { n, len, channel }
+  });
+
+  let received = 0;
+  function done() {
+    bench.end(n);
+    worker.terminate();
+  }
+
+  worker.on('online', () => {
+    bench.start();
+    worker.postMessage('start');
+    if (channel) {
+      (async () => {
+        for await (const record of channel)
+          received += record.length;
+        done();
+      })();
+    } else {
+      worker.on('message', (record) => {
+        received += record.length;
+        if (received === n * len)
+          done();
+      });
+    }
+  });
+}
@@ -0,0 +1,32 @@
+'use strict';
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+const bench = common.createBenchmark(main, {
+  concurrency: [1, 8],
+  snapshot: ['true', 'false'],
+  n: [100]
+});
+
+function main({ n, concurrency, snapshot }) {
+  const execArgv = snapshot === 'true' ? [] : ['--no-node-snapshot'];
+  let started = 0;
+  let exited = 0;
+
+  function spawn() {
+    started++;
+    const worker = new Worker('', { eval: true, execArgv });
+    worker.on('exit', onExit);
+  }
+
+  function onExit() {
+    if (++exited === n)
+      bench.end(n);
+    else if (started < n)
+      spawn();
+  }
+
+  bench.start();
+  for (let i = 0; i < concurrency && started < n; i++)
+    spawn();
+}
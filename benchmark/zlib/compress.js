@@ -0,0 +1,37 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['gzip', 'gzipSync', 'brotliCompress', 'brotliCompressSync'],
+  inputLen: [1024, 16 * 1024, 256 * 1024],
+  n: [4e3]
+});
+
+function main({ n, method, inputLen }) {
+  // A JSON body, as it would be sent in an HTTP response.
+  const items = [];
+  for (let len = 0; len < inputLen; len += 40)
+    items.push({ id: items.length, name: `item ${items.length}`, ok: true });
+  const input = Buffer.from(JSON.stringify(items).slice(0, inputLen));
+  const options = method.startsWith('brotli') ?
+    { params: { [zlib.constants.BROTLI_PARAM_QUALITY]: 4 } } : {};
+  const fn = zlib[method];
+
+  if (method.endsWith('Sync')) {
+    bench.start();
+    for (let i = 0; i < n; ++i)
+      fn(input, options);
+    bench.end(n);
+    return;
+  }
+
+  let i = 0;
+  bench.start();
+  (function next(err) {
+    if (err) throw err;
+    if (i++ === n)
+      return bench.end(n);
+    fn(input, options, next);
+  })();
+}
@@ -0,0 +1,26 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['crc32', 'adler32'],
+  type: ['buffer', 'string'],
+  len: [16, 1024, 64 * 1024, 4 * 1024 * 1024],
+  n: [1e3]
+});
+
+function main({ method, type, len, n }) {
+  const data = type === 'buffer' ?
+    Buffer.alloc(len, 'abcdefghijklmnopqrstuvwxyz') :
+    'abcdefghijklmnopqrstuvwxyz'.repeat(Math.ceil(len / 26)).slice(0, len);
+  const fn = zlib[method];
+  // Scale the iterations so that every size processes a similar number of
+  // bytes.
+  const iterations = Math.max(1, Math.floor(n * 64 * 1024 / len));
+
+  let value = 0;
+  bench.start();
+  for (let i = 0; i < iterations; ++i)
+    value = fn(data, value);
+  bench.end(iterations * len / (1024 * 1024));
+}
@@ -0,0 +1,34 @@
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['gzip', 'deflate'],
+  parallel: [1, 2, 4],
+  blockSize: [128 * 1024],
+  inputLen: [16 * 1024 * 1024],
+  n: [10]
+});
+
+function main({ n, method, parallel, blockSize, inputLen }) {
+  // Mix compressible and incompressible data.
+  const input = Buffer.alloc(inputLen);
+  for (let i = 0; i < inputLen; i += 4096) {
+    if ((i / 4096) % 2 === 0)
+      input.write('lorem ipsum dolor sit amet '.repeat(152), i);
+    else
+      crypto.randomFillSync(input, i, Math.min(4096, inputLen - i));
+  }
+
+  const fn = zlib[method];
+  const options = { parallel, blockSize };
+  let i = 0;
+  bench.start();
+  (function next(err) {
+    if (err) throw err;
+    if (i++ === n)
+      return bench.end(n);
+    fn(input, options, next);
+  })();
+}
@@ -0,0 +1,33 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  type: ['Gzip', 'Deflate', 'Gunzip'],
+  reuseContext: ['true', 'false'],
+  dictionary: ['true', 'false'],
+  inputLen: [1024],
+  n: [2e4]
+});
+
+function main({ n, type, reuseContext, dictionary, inputLen }) {
+  // One short-lived stream per HTTP response body.
+  const body = Buffer.from('{"status":"ok","items":[1,2,3]}'.repeat(
+    Math.ceil(inputLen / 32))).slice(0, inputLen);
+  const options = { reuseContext: reuseContext === 'true' };
+  if (dictionary === 'true' && type !== 'Gzip' && type !== 'Gunzip')
+    options.dictionary = Buffer.from('{"status":"ok","items":[]}');
+  const input = type === 'Gunzip' ? zlib.gzipSync(body) : body;
+  const create = zlib[`create${type}`];
+
+  let i = 0;
+  bench.start();
+  (function next() {
+    if (i++ === n)
+      return bench.end(n);
+    const stream = create(options);
+    stream.on('data', () => {});
+    stream.on('end', next);
+    stream.end(input);
+  })();
+}
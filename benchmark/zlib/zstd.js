@@ -0,0 +1,40 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+// Compares zstd with gzip and brotli at their default settings, and brotli
+// at a quality level that is commonly used for dynamic content.
+const bench = common.createBenchmark(main, {
+  method: ['gzip', 'zstd', 'brotli', 'brotli-q4'],
+  op: ['compress', 'decompress'],
+  inputLen: [16 * 1024, 1024 * 1024],
+  n: [200]
+});
+
+const methods = {
+  'zstd': [zlib.zstdCompressSync, zlib.zstdDecompressSync, {}],
+  'gzip': [zlib.gzipSync, zlib.gunzipSync, {}],
+  'brotli': [zlib.brotliCompressSync, zlib.brotliDecompressSync, {}],
+  'brotli-q4': [zlib.brotliCompressSync, zlib.brotliDecompressSync, {
+    params: { [zlib.constants.BROTLI_PARAM_QUALITY]: 4 }
+  }],
+};
+
+function main({ n, method, op, inputLen }) {
+  // Log-like lines, as in service-to-service payloads and archives.
+  const lines = [];
+  for (let len = 0, i = 0; len < inputLen; i++) {
+    const line = `${i} GET /api/items/${i % 977} 200 ${(i * 7) % 1000}ms\n`;
+    lines.push(line);
+    len += line.length;
+  }
+  const input = Buffer.from(lines.join('')).slice(0, inputLen);
+  const [compress, decompress, options] = methods[method];
+  const fn = op === 'compress' ? compress : decompress;
+  const data = op === 'compress' ? input : compress(input, options);
+
+  bench.start();
+  for (let i = 0; i < n; ++i)
+    fn(data, options);
+  bench.end(n * inputLen / (1024 * 1024));
+}
@@ -332,6 +332,27 @@ shared_optgroup.add_option('--shared-brotli-libpath',
     dest='shared_brotli_libpath',
     help='a directory to search for the shared brotli DLL')
 
+shared_optgroup.add_option('--shared-zstd',
+    action='store_true',
+    dest='shared_zstd',
+    help='link to a shared zstd DLL instead of static linking')
+
+shared_optgroup.add_option('--shared-zstd-includes',
+    action='store',
+    dest='shared_zstd_includes',
+    help='directory containing zstd header files')
+
+shared_optgroup.add_option('--shared-zstd-libname',
+    action='store',
+    dest='shared_zstd_libname',
+    default='zstd',
+    help='alternative lib name to link to [default: %default]')
+
+shared_optgroup.add_option('--shared-zstd-libpath',
+    action='store',
+    dest='shared_zstd_libpath',
+    help='a directory to search for the shared zstd DLL')
+
 shared_optgroup.add_option('--shared-cares',
     action='store_true',
     dest='shared_cares',
@@ -1753,6 +1774,7 @@ configure_library('zlib', output)
 configure_library('http_parser', output)
 configure_library('libuv', output)
 configure_library('brotli', output, pkgname=['libbrotlidec', 'libbrotlienc'])
+configure_library('zstd', output, pkgname='libzstd')
 configure_library('cares', output, pkgname='libcares')
 configure_library('nghttp2', output, pkgname='libnghttp2')
 configure_v8(output)
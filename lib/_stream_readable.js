@@ -27,6 +27,7 @@ const {
   NumberIsNaN,
   ObjectDefineProperties,
   ObjectSetPrototypeOf,
+  Promise,
   Set,
   SymbolAsyncIterator,
   Symbol
@@ -44,6 +45,7 @@ let debug = require('internal/util/debuglog').debuglog('stream', (fn) => {
 });
 const BufferList = require('internal/streams/buffer_list');
 const destroyImpl = require('internal/streams/destroy');
+const { kStringDecoderWriteAll } = require('internal/util');
 const {
   getHighWaterMark,
   getDefaultHighWaterMark
@@ -58,6 +60,7 @@ const {
 const kPaused = Symbol('kPaused');
 
 // Lazy loaded to improve the startup performance.
+let eos;
 let StringDecoder;
 let createReadableStreamAsyncIterator;
 let from;
@@ -347,11 +350,12 @@ Readable.prototype.setEncoding = function(enc) {
   this._readableState.encoding = this._readableState.decoder.encoding;
 
   const buffer = this._readableState.buffer;
-  // Iterate over current buffer to convert already stored Buffers:
-  let content = '';
+  // Convert already stored Buffers in one go.
+  const chunks = [];
   for (const data of buffer) {
-    content += decoder.write(data);
+    chunks.push(data);
   }
+  const content = decoder[kStringDecoderWriteAll](chunks);
   buffer.clear();
   if (content !== '')
     buffer.push(content);
@@ -1077,6 +1081,36 @@ Readable.prototype[SymbolAsyncIterator] = function() {
   return createReadableStreamAsyncIterator(this);
 };
 
+// Reads the stream to its end and resolves with everything it produced: a
+// single Buffer, a string if an encoding was set, or an array of chunks in
+// object mode. Byte chunks are joined with one Buffer.concat() call so that
+// the result is allocated and copied exactly once.
+Readable.prototype.collect = function collect() {
+  if (eos === undefined) eos = require('internal/streams/end-of-stream');
+  const state = this._readableState;
+  return new Promise((resolve, reject) => {
+    const chunks = [];
+    let length = 0;
+    const onData = (chunk) => {
+      chunks.push(chunk);
+      length += chunk.length;
+    };
+    this.on('data', onData);
+    eos(this, { writable: false }, (err) => {
+      this.removeListener('data', onData);
+      if (err) {
+        reject(err);
+      } else if (state.objectMode) {
+        resolve(chunks);
+      } else if (state.decoder) {
+        resolve(chunks.join(''));
+      } else {
+        resolve(Buffer.concat(chunks, length));
+      }
+    });
+  });
+};
+
 // Making it explicit these properties are not enumerable
 // because otherwise some prototype manipulation in
 // userland will fail.
@@ -46,7 +46,9 @@ const {
   byteLengthUtf8,
   compare: _compare,
   compareOffset,
+  concat: bindingConcat,
   createFromString,
+  externalStringSlice,
   fill: bindingFill,
   indexOfBuffer,
   indexOfNumber,
@@ -543,6 +545,16 @@ Buffer.isEncoding = function isEncoding(encoding) {
 };
 Buffer[kIsEncodingSymbol] = Buffer.isEncoding;
 
+// For shorter lists, calling into C++ costs more than it saves.
+const kNativeConcatMinChunks = 8;
+
+function throwInvalidConcatChunk(list, i) {
+  // TODO(BridgeAR): This should not be of type ERR_INVALID_ARG_TYPE.
+  // Instead, find the proper error code for this.
+  throw new ERR_INVALID_ARG_TYPE(
+    `list[${i}]`, ['Buffer', 'Uint8Array'], list[i]);
+}
+
 Buffer.concat = function concat(list, length) {
   if (!ArrayIsArray(list)) {
     throw new ERR_INVALID_ARG_TYPE('list', 'Array', list);
@@ -564,15 +576,19 @@ Buffer.concat = function concat(list, length) {
 
   const buffer = Buffer.allocUnsafe(length);
   let pos = 0;
-  for (let i = 0; i < list.length; i++) {
-    const buf = list[i];
-    if (!isUint8Array(buf)) {
-      // TODO(BridgeAR): This should not be of type ERR_INVALID_ARG_TYPE.
-      // Instead, find the proper error code for this.
-      throw new ERR_INVALID_ARG_TYPE(
-        `list[${i}]`, ['Buffer', 'Uint8Array'], list[i]);
+  if (list.length >= kNativeConcatMinChunks) {
+    // Copy all chunks in a single call, which is a lot faster for long lists
+    // of small chunks, e.g. those collected from a stream.
+    pos = bindingConcat(list, list.length, buffer);
+    if (pos < 0)
+      throwInvalidConcatChunk(list, -1 - pos);
+  } else {
+    for (let i = 0; i < list.length; i++) {
+      const buf = list[i];
+      if (!isUint8Array(buf))
+        throwInvalidConcatChunk(list, i);
+      pos += _copyActual(buf, buffer, pos, 0, buf.length);
     }
-    pos += _copyActual(buf, buffer, pos, 0, buf.length);
   }
 
   // Note: `length` is always equal to `buffer.length` at this point
@@ -803,6 +819,48 @@ Buffer.prototype.toString = function toString(encoding, start, end) {
   return ops.slice(this, start, end);
 };
 
+// Like toString(), but the result shares memory with the buffer where
+// possible. The caller promises not to modify the bytes while the string is
+// in use.
+Buffer.prototype.toExternalString =
+  function toExternalString(encoding, start, end) {
+    const len = this.length;
+
+    if (start === undefined || start <= 0)
+      start = 0;
+    else if (start >= len)
+      return '';
+    else
+      start |= 0;
+
+    if (end === undefined || end > len)
+      end = len;
+    else
+      end |= 0;
+
+    if (end <= start)
+      return '';
+
+    let ops = encodingOps.utf8;
+    if (encoding !== undefined) {
+      ops = getEncodingOps(encoding);
+      if (ops === undefined)
+        throw new ERR_UNKNOWN_ENCODING(encoding);
+    }
+    if (ops !== encodingOps.latin1 &&
+        ops !== encodingOps.ascii &&
+        ops !== encodingOps.utf8) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'encoding', encoding, "must be 'latin1', 'ascii' or 'utf8'");
+    }
+
+    // Bytes above 0x7f decode differently in ASCII and UTF-8, so those
+    // ranges are only shared when they are pure ASCII.
+    const str = externalStringSlice(this, start, end,
+                                    ops !== encodingOps.latin1);
+    return str !== undefined ? str : ops.slice(this, start, end);
+  };
+
 Buffer.prototype.equals = function equals(otherBuffer) {
   if (!isUint8Array(otherBuffer)) {
     throw new ERR_INVALID_ARG_TYPE(
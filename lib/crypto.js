@@ -48,7 +48,8 @@ const { getFipsCrypto, setFipsCrypto } = internalBinding('crypto');
 const {
   randomBytes,
   randomFill,
-  randomFillSync
+  randomFillSync,
+  randomUUID
 } = require('internal/crypto/random');
 const {
   pbkdf2,
@@ -181,6 +182,7 @@ module.exports = {
   randomBytes,
   randomFill,
   randomFillSync,
+  randomUUID,
   scrypt,
   scryptSync,
   sign: signOneShot,
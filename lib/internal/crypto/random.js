@@ -3,6 +3,8 @@
 const {
   MathMin,
   NumberIsNaN,
+  NumberPrototypeToString,
+  StringPrototypePadStart,
 } = primordials;
 
 const { AsyncWrap, Providers } = internalBinding('async_wrap');
@@ -13,9 +15,14 @@ const {
   ERR_INVALID_CALLBACK,
   ERR_OUT_OF_RANGE
 } = require('internal/errors').codes;
-const { validateNumber } = require('internal/validators');
+const {
+  validateBoolean,
+  validateNumber,
+  validateObject,
+} = require('internal/validators');
 const { isArrayBufferView } = require('internal/util/types');
 const { FastBuffer } = require('internal/buffer');
+const { getOptionValue } = require('internal/options');
 
 const kMaxUint32 = 2 ** 32 - 1;
 const kMaxPossibleLength = MathMin(kMaxLength, kMaxUint32);
@@ -53,6 +60,9 @@ function randomBytes(size, cb) {
   if (cb !== undefined && typeof cb !== 'function')
     throw new ERR_INVALID_CALLBACK(cb);
 
+  if (!cb && size <= kMaxPooledRandomBytes && size > 0 && !noEntropyCache)
+    return getPooledRandomBytes(size);
+
   const buf = new FastBuffer(size);
 
   if (!cb) return handleError(_randomBytes(buf, 0, size), buf);
@@ -119,6 +129,134 @@ function randomFill(buf, offset, size, cb) {
   _randomBytes(buf, offset, size, wrap);
 }
 
+// Implements an RFC 4122 version 4 random UUID.
+// To improve performance, random data is generated in batches large enough to
+// cover kUUIDBatchSize UUIDs at a time, and each call to randomUUID() consumes
+// 16 bytes from the current batch. Two batch buffers are kept: while one is
+// being consumed, the other one is refilled on the threadpool, so that in the
+// common case serving a UUID does not call into the CSPRNG at all.
+// Small synchronous randomBytes() calls are served from the same batches.
+const kUUIDBatchSize = 128;
+const kUUIDBatchBytes = 16 * kUUIDBatchSize;
+// Larger requests would use up a batch too quickly for the refill to keep up.
+const kMaxPooledRandomBytes = 64;
+// With --no-crypto-entropy-cache, no batches are used at all.
+const noEntropyCache = getOptionValue('--no-crypto-entropy-cache');
+
+const kHexBytes = [];
+for (let i = 0; i < 256; i++) {
+  kHexBytes[i] =
+    StringPrototypePadStart(NumberPrototypeToString(i, 16), 2, '0');
+}
+
+let uuidData;
+let uuidSpare;
+let uuidSpareReady = false;
+let uuidSpareRefilling = false;
+let uuidOffset = kUUIDBatchBytes;
+let uuidNotBuffered;
+
+function refillUUIDSpare() {
+  uuidSpareRefilling = true;
+  const wrap = new AsyncWrap(Providers.RANDOMBYTESREQUEST);
+  wrap.ondone = (ex) => {
+    uuidSpareRefilling = false;
+    // On failure, the next exhausted batch is filled synchronously instead,
+    // which surfaces the error to the caller.
+    uuidSpareReady = !ex;
+  };
+  _randomBytes(uuidSpare, 0, kUUIDBatchBytes, wrap);
+}
+
+function nextUUIDBatch() {
+  if (uuidData === undefined) {
+    uuidData = new FastBuffer(kUUIDBatchBytes);
+    uuidSpare = new FastBuffer(kUUIDBatchBytes);
+  }
+
+  if (uuidSpareReady) {
+    const data = uuidData;
+    uuidData = uuidSpare;
+    uuidSpare = data;
+    uuidSpareReady = false;
+  } else {
+    handleError(_randomBytes(uuidData, 0, kUUIDBatchBytes), uuidData);
+  }
+
+  // Never hand out the same bytes twice: the consumed batch is only reused
+  // after it has been overwritten with fresh random data.
+  if (!uuidSpareRefilling)
+    refillUUIDSpare();
+  uuidOffset = 0;
+}
+
+// Returns the offset of `size` unused bytes in uuidData and marks them as
+// consumed. Bytes left over at the end of a batch are discarded.
+function takeBufferedBytes(size) {
+  if (uuidOffset + size > kUUIDBatchBytes)
+    nextUUIDBatch();
+  const offset = uuidOffset;
+  uuidOffset += size;
+  return offset;
+}
+
+function getPooledRandomBytes(size) {
+  const offset = takeBufferedBytes(size);
+  const buf = new FastBuffer(size);
+  uuidData.copy(buf, 0, offset, offset + size);
+  return buf;
+}
+
+function getBufferedUUID() {
+  const offset = takeBufferedBytes(16);
+  return serializeUUID(uuidData, offset);
+}
+
+function getUnbufferedUUID() {
+  if (uuidNotBuffered === undefined)
+    uuidNotBuffered = new FastBuffer(16);
+  handleError(_randomBytes(uuidNotBuffered, 0, 16), uuidNotBuffered);
+  return serializeUUID(uuidNotBuffered, 0);
+}
+
+function serializeUUID(buf, offset) {
+  // xxxxxxxx-xxxx-Mxxx-Nxxx-xxxxxxxxxxxx, where M is the version (4) and the
+  // two most significant bits of N are the variant (0b10).
+  return kHexBytes[buf[offset]] +
+    kHexBytes[buf[offset + 1]] +
+    kHexBytes[buf[offset + 2]] +
+    kHexBytes[buf[offset + 3]] +
+    '-' +
+    kHexBytes[buf[offset + 4]] +
+    kHexBytes[buf[offset + 5]] +
+    '-' +
+    kHexBytes[(buf[offset + 6] & 0x0f) | 0x40] +
+    kHexBytes[buf[offset + 7]] +
+    '-' +
+    kHexBytes[(buf[offset + 8] & 0x3f) | 0x80] +
+    kHexBytes[buf[offset + 9]] +
+    '-' +
+    kHexBytes[buf[offset + 10]] +
+    kHexBytes[buf[offset + 11]] +
+    kHexBytes[buf[offset + 12]] +
+    kHexBytes[buf[offset + 13]] +
+    kHexBytes[buf[offset + 14]] +
+    kHexBytes[buf[offset + 15]];
+}
+
+function randomUUID(options) {
+  if (options !== undefined)
+    validateObject(options, 'options');
+  const {
+    disableEntropyCache = false,
+  } = options || {};
+
+  validateBoolean(disableEntropyCache, 'options.disableEntropyCache');
+
+  return disableEntropyCache || noEntropyCache ?
+    getUnbufferedUUID() : getBufferedUUID();
+}
+
 function handleError(ex, buf) {
   if (ex) throw ex;
   return buf;
@@ -127,5 +265,6 @@ function handleError(ex, buf) {
 module.exports = {
   randomBytes,
   randomFill,
-  randomFillSync
+  randomFillSync,
+  randomUUID
 };
@@ -24,6 +24,7 @@ const kFlags = Symbol('flags');
 const kEncoding = Symbol('encoding');
 const kDecoder = Symbol('decoder');
 const kEncoder = Symbol('encoder');
+const kUTF8FastPath = Symbol('utf8 fast path');
 
 const {
   getConstructorOf,
@@ -43,6 +44,11 @@ const {
   encodeUtf8String
 } = internalBinding('buffer');
 
+const {
+  decodeUTF8,
+  kUTF8DecoderSize
+} = internalBinding('string_decoder');
+
 let Buffer;
 function lazyBuffer() {
   if (Buffer === undefined)
@@ -365,6 +371,21 @@ ObjectDefineProperties(
       value: 'TextEncoder'
     } });
 
+// UTF-8 is decoded by a dedicated native decoder that keeps its state in a
+// small Uint8Array, both with and without ICU. It avoids the intermediate
+// UTF-16 buffer of the ICU converter and creates one-byte strings directly
+// from ASCII input.
+function createUTF8Handle() {
+  return new Uint8Array(kUTF8DecoderSize);
+}
+
+function decodeUTF8Chunk(decoder, input, flags) {
+  const ret = decodeUTF8(decoder[kHandle], input, flags);
+  if (ret === undefined)
+    throw new ERR_ENCODING_INVALID_ENCODED_DATA(decoder.encoding);
+  return ret;
+}
+
 const TextDecoder =
   internalBinding('config').hasIntl ?
     makeTextDecoderICU() :
@@ -391,7 +412,8 @@ function makeTextDecoderICU() {
         flags |= options.ignoreBOM ? CONVERTER_FLAGS_IGNORE_BOM : 0;
       }
 
-      const handle = getConverter(enc, flags);
+      const isUTF8 = enc === 'utf-8';
+      const handle = isUTF8 ? createUTF8Handle() : getConverter(enc, flags);
       if (handle === undefined)
         throw new ERR_ENCODING_NOT_SUPPORTED(encoding);
 
@@ -399,6 +421,7 @@ function makeTextDecoderICU() {
       this[kHandle] = handle;
       this[kFlags] = flags;
       this[kEncoding] = enc;
+      this[kUTF8FastPath] = isUTF8;
     }
 
 
@@ -417,6 +440,9 @@ function makeTextDecoderICU() {
       if (options !== null)
         flags |= options.stream ? 0 : CONVERTER_FLAGS_FLUSH;
 
+      if (this[kUTF8FastPath])
+        return decodeUTF8Chunk(this, input, this[kFlags] | flags);
+
       const ret = _decode(this[kHandle], input, flags);
       if (typeof ret === 'number') {
         throw new ERR_ENCODING_INVALID_ENCODED_DATA(this.encoding, ret);
@@ -454,17 +480,23 @@ function makeTextDecoderJS() {
       let flags = 0;
       if (options !== null) {
         if (options.fatal) {
-          throw new ERR_NO_ICU('"fatal" option');
+          if (enc !== 'utf-8')
+            throw new ERR_NO_ICU('"fatal" option');
+          flags |= CONVERTER_FLAGS_FATAL;
         }
         flags |= options.ignoreBOM ? CONVERTER_FLAGS_IGNORE_BOM : 0;
       }
 
+      const isUTF8 = enc === 'utf-8';
       this[kDecoder] = true;
       // StringDecoder will normalize WHATWG encoding to Node.js encoding.
-      this[kHandle] = new (lazyStringDecoder())(enc);
+      this[kHandle] = isUTF8 ?
+        createUTF8Handle() :
+        new (lazyStringDecoder())(enc);
       this[kFlags] = flags;
       this[kEncoding] = enc;
       this[kBOMSeen] = false;
+      this[kUTF8FastPath] = isUTF8;
     }
 
     decode(input = empty, options = {}) {
@@ -491,6 +523,9 @@ function makeTextDecoderJS() {
         this[kFlags] |= CONVERTER_FLAGS_FLUSH;
       }
 
+      if (this[kUTF8FastPath])
+        return decodeUTF8Chunk(this, input, this[kFlags]);
+
       let result = this[kFlags] & CONVERTER_FLAGS_FLUSH ?
         this[kHandle].end(input) :
         this[kHandle].write(input);
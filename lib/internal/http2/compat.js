@@ -279,11 +279,12 @@ function onStreamCloseRequest() {
   req.emit('close');
 }
 
-function onStreamTimeout(kind) {
-  return function onStreamTimeout() {
-    const obj = this[kind];
-    obj.emit('timeout');
-  };
+function onStreamTimeoutRequest() {
+  this[kRequest].emit('timeout');
+}
+
+function onStreamTimeoutResponse() {
+  this[kResponse].emit('timeout');
 }
 
 class Http2ServerRequest extends Readable {
@@ -311,7 +312,7 @@ class Http2ServerRequest extends Readable {
     stream.on('error', onStreamError);
     stream.on('aborted', onStreamAbortedRequest);
     stream.on('close', onStreamCloseRequest);
-    stream.on('timeout', onStreamTimeout(kRequest));
+    stream.on('timeout', onStreamTimeoutRequest);
     this.on('pause', onRequestPause);
     this.on('resume', onRequestResume);
   }
@@ -453,6 +454,8 @@ class Http2ServerResponse extends Stream {
       headRequest: false,
       sendDate: true,
       statusCode: HTTP_STATUS_OK,
+      hasTrailers: false,
+      endingWithBody: false,
     };
     this[kHeaders] = ObjectCreate(null);
     this[kTrailers] = ObjectCreate(null);
@@ -464,7 +467,7 @@ class Http2ServerResponse extends Stream {
     stream.on('aborted', onStreamAbortedResponse);
     stream.on('close', onStreamCloseResponse);
     stream.on('wantTrailers', onStreamTrailersReady);
-    stream.on('timeout', onStreamTimeout(kResponse));
+    stream.on('timeout', onStreamTimeoutResponse);
   }
 
   // User land modules such as finalhandler just check truthiness of this
@@ -551,6 +554,7 @@ class Http2ServerResponse extends Stream {
     name = name.trim().toLowerCase();
     assertValidHeader(name, value);
     this[kTrailers][name] = value;
+    this[kState].hasTrailers = true;
   }
 
   addTrailers(headers) {
@@ -722,8 +726,22 @@ class Http2ServerResponse extends Stream {
       encoding = 'utf8';
     }
 
-    if (chunk !== null && chunk !== undefined)
-      this.write(chunk, encoding);
+    // If the headers have not been sent yet, the complete response is known
+    // at this point. In that case, the headers are sent without waiting for
+    // trailers (unless some were set), and the body is passed to the stream
+    // together with the end of the stream. This saves the 'wantTrailers'
+    // round trip and the empty DATA frame that would otherwise be needed to
+    // close the stream.
+    let endChunk = null;
+    if (chunk !== null && chunk !== undefined) {
+      if (!stream.headersSent && !state.closed && !state.destroyed &&
+          !stream.destroyed) {
+        endChunk = chunk;
+        state.endingWithBody = true;
+      } else {
+        this.write(chunk, encoding);
+      }
+    }
 
     state.headRequest = stream.headRequest;
     state.ending = true;
@@ -740,6 +758,10 @@ class Http2ServerResponse extends Stream {
 
     if (this[kState].closed || stream.destroyed)
       onStreamCloseResponse.call(stream);
+    // Responses without a body (e.g. to HEAD requests) have already been
+    // ended by respond(), so the chunk is dropped in that case.
+    else if (endChunk !== null && !stream.writableEnded)
+      stream.end(endChunk, encoding);
     else
       stream.end();
 
@@ -781,8 +803,8 @@ class Http2ServerResponse extends Stream {
     const headers = this[kHeaders];
     headers[HTTP2_HEADER_STATUS] = state.statusCode;
     const options = {
-      endStream: state.ending,
-      waitForTrailers: true,
+      endStream: state.ending && !state.endingWithBody,
+      waitForTrailers: !state.ending || state.hasTrailers,
     };
     this[kStream].respond(headers, options);
   }
@@ -185,6 +185,7 @@ function debugSessionObj(session, message, ...args) {
 
 const kMaxFrameSize = (2 ** 24) - 1;
 const kMaxInt = (2 ** 32) - 1;
+const kMaxWindowSize = (2 ** 31) - 1;
 const kMaxStreams = (2 ** 32) - 1;
 const kMaxALTSVC = (2 ** 14) - 2;
 
@@ -2864,11 +2865,21 @@ function connectionListener(socket) {
   this.emit('session', session);
 }
 
+// Validates the session options that are passed to the native layer
+// through the options buffer, where they are stored as Uint32 values.
+function validateSessionOptions(options) {
+  if (options.maxAutotunedWindowSize !== undefined) {
+    validateInteger(options.maxAutotunedWindowSize,
+                    'maxAutotunedWindowSize', 0, kMaxWindowSize);
+  }
+}
+
 function initializeOptions(options) {
   assertIsObject(options, 'options');
   options = { ...options };
   assertIsObject(options.settings, 'options.settings');
   options.settings = { ...options.settings };
+  validateSessionOptions(options);
 
   if (options.maxSessionInvalidFrames !== undefined)
     validateUint32(options.maxSessionInvalidFrames, 'maxSessionInvalidFrames');
@@ -3019,6 +3030,7 @@ function connect(authority, options, listener) {
 
   assertIsObject(options, 'options');
   options = { ...options };
+  validateSessionOptions(options);
 
   if (typeof authority === 'string')
     authority = new URL(authority);
@@ -187,6 +187,11 @@ const IDX_SESSION_STATE_REMOTE_WINDOW_SIZE = 5;
 const IDX_SESSION_STATE_OUTBOUND_QUEUE_SIZE = 6;
 const IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE = 7;
 const IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE = 8;
+const IDX_SESSION_STATE_HEADER_STRING_CACHE_HITS = 9;
+const IDX_SESSION_STATE_HEADER_STRING_CACHE_MISSES = 10;
+const IDX_SESSION_STATE_AUTOTUNED_WINDOW_SIZE = 11;
+const IDX_SESSION_STATE_BDP_ESTIMATE = 12;
+const IDX_SESSION_STATE_RTT = 13;
 const IDX_STREAM_STATE = 0;
 const IDX_STREAM_STATE_WEIGHT = 1;
 const IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT = 2;
@@ -204,7 +209,8 @@ const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
 const IDX_OPTIONS_MAX_SETTINGS = 9;
-const IDX_OPTIONS_FLAGS = 10;
+const IDX_OPTIONS_MAX_AUTOTUNED_WINDOW_SIZE = 10;
+const IDX_OPTIONS_FLAGS = 11;
 
 function updateOptionsBuffer(options) {
   let flags = 0;
@@ -258,6 +264,11 @@ function updateOptionsBuffer(options) {
     optionsBuffer[IDX_OPTIONS_MAX_SETTINGS] =
       MathMax(1, options.maxSettings);
   }
+  if (typeof options.maxAutotunedWindowSize === 'number') {
+    flags |= (1 << IDX_OPTIONS_MAX_AUTOTUNED_WINDOW_SIZE);
+    optionsBuffer[IDX_OPTIONS_MAX_AUTOTUNED_WINDOW_SIZE] =
+      MathMax(0, options.maxAutotunedWindowSize);
+  }
   optionsBuffer[IDX_OPTIONS_FLAGS] = flags;
 }
 
@@ -393,7 +404,17 @@ function getSessionState(session) {
     deflateDynamicTableSize:
       sessionState[IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE],
     inflateDynamicTableSize:
-      sessionState[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE]
+      sessionState[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE],
+    headerStringCacheHits:
+      sessionState[IDX_SESSION_STATE_HEADER_STRING_CACHE_HITS],
+    headerStringCacheMisses:
+      sessionState[IDX_SESSION_STATE_HEADER_STRING_CACHE_MISSES],
+    autotunedWindowSize:
+      sessionState[IDX_SESSION_STATE_AUTOTUNED_WINDOW_SIZE],
+    bdpEstimate:
+      sessionState[IDX_SESSION_STATE_BDP_ESTIMATE],
+    rtt:
+      sessionState[IDX_SESSION_STATE_RTT]
   };
 }
 
@@ -2,6 +2,7 @@
 
 const {
   Array,
+  Int32Array,
   Number,
   ObjectCreate,
   ObjectDefineProperties,
@@ -27,6 +28,7 @@ const { getConstructorOf, removeColors } = require('internal/util');
 const {
   ERR_ARG_NOT_ITERABLE,
   ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_ARG_VALUE,
   ERR_INVALID_CALLBACK,
   ERR_INVALID_FILE_URL_HOST,
   ERR_INVALID_FILE_URL_PATH,
@@ -47,6 +49,7 @@ const {
   CHAR_PLUS
 } = require('internal/constants');
 const path = require('path');
+const { validateArray, validateString } = require('internal/validators');
 
 // Lazy loaded for startup performance.
 let querystring;
@@ -60,6 +63,8 @@ const {
   encodeAuth,
   toUSVString: _toUSVString,
   parse,
+  parseHref,
+  RouteTable: _RouteTable,
   setURLConstructor,
   URL_FLAGS_CANNOT_BE_BASE,
   URL_FLAGS_HAS_FRAGMENT,
@@ -76,10 +81,24 @@ const {
   kPathStart,
   kPort,
   kQuery,
-  kSchemeStart
+  kSchemeStart,
+  kComponentFlags,
+  kComponentPort,
+  kProtocolEnd,
+  kUsernameEnd,
+  kHostStart,
+  kHostEnd,
+  kPathnameStart,
+  kSearchStart,
+  kHashStart,
+  kComponentCount
 } = internalBinding('url');
 
 const context = Symbol('context');
+// The serialized URL, or null if it needs to be recomputed from the context
+// because the URL was modified. This is a non-enumerable property, so that it
+// does not affect assert.deepStrictEqual().
+const kHref = Symbol('kHref');
 const cannotBeBase = Symbol('cannot-be-base');
 const cannotHaveUsernamePasswordPort =
     Symbol('cannot-have-username-password-port');
@@ -104,6 +123,9 @@ function toUSVString(val) {
   return _toUSVString(str, match.index);
 }
 
+// Filled in by parseHref().
+const urlComponents = new Int32Array(kComponentCount);
+
 // Refs: https://html.spec.whatwg.org/multipage/browsers.html#concept-origin-opaque
 const kOpaqueOrigin = 'null';
 
@@ -236,6 +258,7 @@ class URLSearchParams {
 function onParseComplete(flags, protocol, username, password,
                          host, port, path, query, fragment) {
   const ctx = this[context];
+  this[kHref] = null;
   ctx.flags = flags;
   ctx.scheme = protocol;
   ctx.username = (flags & URL_FLAGS_HAS_USERNAME) !== 0 ? username : '';
@@ -245,11 +268,62 @@ function onParseComplete(flags, protocol, username, password,
   ctx.query = query;
   ctx.fragment = fragment;
   ctx.host = host;
-  if (!this[searchParams]) { // Invoked from URL constructor
-    this[searchParams] = new URLSearchParams();
-    this[searchParams][context] = this;
+  initURLSearchParams(this, query);
+}
+
+function initURLSearchParams(url, query) {
+  if (!url[searchParams]) { // Invoked from URL constructor
+    url[searchParams] = new URLSearchParams();
+    url[searchParams][context] = url;
+  }
+  initSearchParams(url[searchParams], query);
+}
+
+// Fast path for parse(): the URL is serialized in C++, and the components are
+// sliced out of the serialized URL here instead of being converted one by one.
+// Returns false if parse() needs to be used instead.
+function parseInto(url, input, base_context) {
+  const href = parseHref(input, base_context, urlComponents);
+  if (href === undefined)
+    throw new ERR_INVALID_URL(input);
+  if (href === null)
+    return false;
+
+  const flags = urlComponents[kComponentFlags];
+  const port = urlComponents[kComponentPort];
+  const protocolEnd = urlComponents[kProtocolEnd];
+  const usernameEnd = urlComponents[kUsernameEnd];
+  const hostStart = urlComponents[kHostStart];
+  const pathnameStart = urlComponents[kPathnameStart];
+  const searchStart = urlComponents[kSearchStart];
+  const hashStart = urlComponents[kHashStart];
+  const ctx = url[context];
+  ctx.flags = flags;
+  ctx.scheme = href.slice(0, protocolEnd);
+  ctx.username = (flags & URL_FLAGS_HAS_USERNAME) !== 0 ?
+    href.slice(protocolEnd + 2, usernameEnd) : '';
+  ctx.password = (flags & URL_FLAGS_HAS_PASSWORD) !== 0 ?
+    href.slice(usernameEnd + 1, hostStart - 1) : '';
+  ctx.port = port === -1 ? null : port;
+  if ((flags & URL_FLAGS_HAS_PATH) === 0) {
+    ctx.path = [];
+  } else if ((flags & URL_FLAGS_CANNOT_BE_BASE) !== 0) {
+    ctx.path = [href.slice(pathnameStart, searchStart)];
+  } else if (pathnameStart === searchStart) {
+    ctx.path = [];
+  } else {
+    ctx.path = href.slice(pathnameStart + 1, searchStart).split('/');
   }
-  initSearchParams(this[searchParams], query);
+  const query = (flags & URL_FLAGS_HAS_QUERY) !== 0 ?
+    href.slice(searchStart + 1, hashStart) : null;
+  ctx.query = query;
+  ctx.fragment = (flags & URL_FLAGS_HAS_FRAGMENT) !== 0 ?
+    href.slice(hashStart + 1) : null;
+  ctx.host = (flags & URL_FLAGS_HAS_HOST) !== 0 ?
+    href.slice(hostStart, urlComponents[kHostEnd]) : null;
+  url[kHref] = href;
+  initURLSearchParams(url, query);
+  return true;
 }
 
 function onParseError(flags, input) {
@@ -329,8 +403,11 @@ class URL {
       base_context = new URL(base)[context];
     }
     this[context] = new URLContext();
-    parse(input, -1, base_context, undefined, onParseComplete.bind(this),
-          onParseError);
+    ObjectDefineProperty(this, kHref, { writable: true, value: null });
+    if (!parseInto(this, input, base_context)) {
+      parse(input, -1, base_context, undefined, onParseComplete.bind(this),
+            onParseError);
+    }
   }
 
   get [special]() {
@@ -439,20 +516,22 @@ ObjectDefineProperties(URL.prototype, {
     configurable: true,
     // eslint-disable-next-line func-name-matching
     value: function toString() {
-      return this[kFormat]({});
+      return serializeURL(this);
     }
   },
   href: {
     enumerable: true,
     configurable: true,
     get() {
-      return this[kFormat]({});
+      return serializeURL(this);
     },
     set(input) {
       // toUSVString is not needed.
       input = `${input}`;
-      parse(input, -1, undefined, undefined, onParseComplete.bind(this),
-            onParseError);
+      if (!parseInto(this, input, undefined)) {
+        parse(input, -1, undefined, undefined, onParseComplete.bind(this),
+              onParseError);
+      }
     }
   },
   origin: {  // readonly
@@ -493,6 +572,7 @@ ObjectDefineProperties(URL.prototype, {
       if (scheme.length === 0)
         return;
       const ctx = this[context];
+      this[kHref] = null;
       if (ctx.scheme === 'file:' &&
           (ctx.host === '' || ctx.host === null)) {
         return;
@@ -513,6 +593,7 @@ ObjectDefineProperties(URL.prototype, {
       if (this[cannotHaveUsernamePasswordPort])
         return;
       const ctx = this[context];
+      this[kHref] = null;
       if (username === '') {
         ctx.username = '';
         ctx.flags &= ~URL_FLAGS_HAS_USERNAME;
@@ -534,6 +615,7 @@ ObjectDefineProperties(URL.prototype, {
       if (this[cannotHaveUsernamePasswordPort])
         return;
       const ctx = this[context];
+      this[kHref] = null;
       if (password === '') {
         ctx.password = '';
         ctx.flags &= ~URL_FLAGS_HAS_PASSWORD;
@@ -555,6 +637,7 @@ ObjectDefineProperties(URL.prototype, {
     },
     set(host) {
       const ctx = this[context];
+      this[kHref] = null;
       // toUSVString is not needed.
       host = `${host}`;
       if (this[cannotBeBase]) {
@@ -572,6 +655,7 @@ ObjectDefineProperties(URL.prototype, {
     },
     set(host) {
       const ctx = this[context];
+      this[kHref] = null;
       // toUSVString is not needed.
       host = `${host}`;
       if (this[cannotBeBase]) {
@@ -594,6 +678,7 @@ ObjectDefineProperties(URL.prototype, {
       if (this[cannotHaveUsernamePasswordPort])
         return;
       const ctx = this[context];
+      this[kHref] = null;
       if (port === '') {
         ctx.port = null;
         return;
@@ -617,6 +702,7 @@ ObjectDefineProperties(URL.prototype, {
       path = `${path}`;
       if (this[cannotBeBase])
         return;
+      this[kHref] = null;
       parse(path, kPathStart, null, this[context],
             onParsePathComplete.bind(this));
     }
@@ -632,6 +718,7 @@ ObjectDefineProperties(URL.prototype, {
     },
     set(search) {
       const ctx = this[context];
+      this[kHref] = null;
       search = toUSVString(search);
       if (search === '') {
         ctx.query = null;
@@ -665,6 +752,7 @@ ObjectDefineProperties(URL.prototype, {
     },
     set(hash) {
       const ctx = this[context];
+      this[kHref] = null;
       // toUSVString is not needed.
       hash = `${hash}`;
       if (!hash) {
@@ -684,16 +772,26 @@ ObjectDefineProperties(URL.prototype, {
     configurable: true,
     // eslint-disable-next-line func-name-matching
     value: function toJSON() {
-      return this[kFormat]({});
+      return serializeURL(this);
     }
   }
 });
 
+function serializeURL(url) {
+  let href = url[kHref];
+  if (typeof href !== 'string') {
+    href = url[kFormat]({});
+    url[kHref] = href;
+  }
+  return href;
+}
+
 function update(url, params) {
   if (!url)
     return;
 
   const ctx = url[context];
+  url[kHref] = null;
   const serializedParams = params.toString();
   if (serializedParams) {
     ctx.query = serializedParams;
@@ -1400,6 +1498,77 @@ function toPathIfFileURL(fileURLOrPath) {
   return fileURLToPath(fileURLOrPath);
 }
 
+const kRouteTable = Symbol('kRouteTable');
+const kParamNames = Symbol('kParamNames');
+const kParamSegment = /^:[A-Za-z_$][\w$]*$/;
+
+// Returns the names of the values that are captured by `pattern`.
+function parseRoutePattern(pattern, name) {
+  if (pattern[0] !== '/')
+    throw new ERR_INVALID_ARG_VALUE(name, pattern, 'must start with "/"');
+  if (pattern.includes('?') || pattern.includes('#')) {
+    throw new ERR_INVALID_ARG_VALUE(
+      name, pattern, 'must not contain "?" or "#"');
+  }
+  const segments = pattern.split('/');
+  const paramNames = [];
+  for (let i = 1; i < segments.length; i++) {
+    const segment = segments[i];
+    if (segment === '*') {
+      if (i !== segments.length - 1) {
+        throw new ERR_INVALID_ARG_VALUE(
+          name, pattern, 'can only contain "*" as the last segment');
+      }
+      paramNames.push('0');
+    } else if (segment[0] === ':') {
+      if (!kParamSegment.test(segment)) {
+        throw new ERR_INVALID_ARG_VALUE(
+          name, pattern, `contains an invalid parameter name "${segment}"`);
+      }
+      const paramName = segment.slice(1);
+      if (paramNames.includes(paramName)) {
+        throw new ERR_INVALID_ARG_VALUE(
+          name, pattern, `contains the parameter "${segment}" twice`);
+      }
+      paramNames.push(paramName);
+    }
+  }
+  return paramNames;
+}
+
+class RouteTable {
+  constructor(patterns) {
+    validateArray(patterns, 'patterns');
+    const table = new _RouteTable();
+    const paramNames = [];
+    for (let i = 0; i < patterns.length; i++) {
+      const name = `patterns[${i}]`;
+      const pattern = patterns[i];
+      validateString(pattern, name);
+      paramNames.push(parseRoutePattern(pattern, name));
+      if (!table.add(pattern, i)) {
+        throw new ERR_INVALID_ARG_VALUE(
+          name, pattern, 'is equivalent to an earlier pattern');
+      }
+    }
+    this[kRouteTable] = table;
+    this[kParamNames] = paramNames;
+  }
+
+  match(path) {
+    validateString(path, 'path');
+    const result = this[kRouteTable].match(path);
+    if (result === undefined)
+      return null;
+    const id = result[0];
+    const paramNames = this[kParamNames][id];
+    const params = ObjectCreate(null);
+    for (let i = 0; i < paramNames.length; i++)
+      params[paramNames[i]] = result[i + 1];
+    return { id, params };
+  }
+}
+
 function constructUrl(flags, protocol, username, password,
                       host, port, path, query, fragment) {
   const ctx = new URLContext();
@@ -1415,6 +1584,7 @@ function constructUrl(flags, protocol, username, password,
 
   const url = ObjectCreate(URL.prototype);
   url[context] = ctx;
+  ObjectDefineProperty(url, kHref, { writable: true, value: null });
   const params = new URLSearchParams();
   url[searchParams] = params;
   params[context] = url;
@@ -1431,6 +1601,7 @@ module.exports = {
   isURLInstance,
   URL,
   URLSearchParams,
+  RouteTable,
   domainToASCII,
   domainToUnicode,
   urlToOptions,
@@ -435,5 +435,6 @@ module.exports = {
   // Used by the buffer module to capture an internal reference to the
   // default isEncoding implementation, just in case userland overrides it.
   kIsEncodingSymbol: Symbol('kIsEncodingSymbol'),
+  kStringDecoderWriteAll: Symbol('kStringDecoderWriteAll'),
   kVmBreakFirstLineSymbol: Symbol('kVmBreakFirstLineSymbol')
 };
@@ -4,6 +4,7 @@
 
 const {
   ArrayIsArray,
+  FunctionPrototypeBind,
   MathMax,
   ObjectCreate,
   ObjectEntries,
@@ -55,6 +56,8 @@ const {
   kMaxOldGenerationSizeMb,
   kCodeRangeSizeMb,
   kStackSizeMb,
+  kMaxCpuTimeMs,
+  kMaxEventLoopDelayMs,
   kTotalResourceLimitCount
 } = internalBinding('worker');
 
@@ -66,6 +69,7 @@ const kOnMessage = Symbol('kOnMessage');
 const kOnCouldNotSerializeErr = Symbol('kOnCouldNotSerializeErr');
 const kOnErrorMessage = Symbol('kOnErrorMessage');
 const kParentSideStdio = Symbol('kParentSideStdio');
+const kCpuUsage = Symbol('kCpuUsage');
 
 const SHARE_ENV = SymbolFor('nodejs.worker_threads.SHARE_ENV');
 let debug = require('internal/util/debuglog').debuglog('worker', (fn) => {
@@ -185,6 +189,11 @@ class Worker extends EventEmitter {
 
     this[kParentSideStdio] = { stdin, stdout, stderr };
 
+    this[kCpuUsage] = [0, 0];
+    this.performance = {
+      eventLoopUtilization: FunctionPrototypeBind(eventLoopUtilization, this),
+    };
+
     const { port1, port2 } = new MessageChannel();
     const transferList = [port2];
     // If transferList is provided.
@@ -264,6 +273,7 @@ class Worker extends EventEmitter {
   }
 
   [kDispose]() {
+    this[kCpuUsage] = this[kHandle].getCpuUsage();
     this[kHandle].onexit = null;
     this[kHandle] = null;
     this[kPort] = null;
@@ -363,6 +373,26 @@ class Worker extends EventEmitter {
   }
 }
 
+// The time that the thread has been running is split into the time during
+// which it was running on a CPU (`active`), and the rest (`idle`).
+function eventLoopUtilization(util1, util2) {
+  const [elapsed, cpu] = this[kHandle] !== null ?
+    this[kHandle].getCpuUsage() : this[kCpuUsage];
+  let active = cpu;
+  let idle = MathMax(elapsed - cpu, 0);
+
+  if (util2) {
+    active = util1.active - util2.active;
+    idle = util1.idle - util2.idle;
+  } else if (util1) {
+    active -= util1.active;
+    idle -= util1.idle;
+  }
+
+  const total = active + idle;
+  return { idle, active, utilization: total > 0 ? active / total : 0 };
+}
+
 function pipeWithoutWarning(source, dest) {
   const sourceMaxListeners = source._maxListeners;
   const destMaxListeners = dest._maxListeners;
@@ -389,6 +419,10 @@ function parseResourceLimits(obj) {
     ret[kCodeRangeSizeMb] = obj.codeRangeSizeMb;
   if (typeof obj.stackSizeMb === 'number')
     ret[kStackSizeMb] = obj.stackSizeMb;
+  if (typeof obj.maxCpuTimeMs === 'number')
+    ret[kMaxCpuTimeMs] = obj.maxCpuTimeMs;
+  if (typeof obj.maxEventLoopDelayMs === 'number')
+    ret[kMaxEventLoopDelayMs] = obj.maxEventLoopDelayMs;
   return ret;
 }
 
@@ -397,7 +431,11 @@ function makeResourceLimits(float64arr) {
     maxYoungGenerationSizeMb: float64arr[kMaxYoungGenerationSizeMb],
     maxOldGenerationSizeMb: float64arr[kMaxOldGenerationSizeMb],
     codeRangeSizeMb: float64arr[kCodeRangeSizeMb],
-    stackSizeMb: float64arr[kStackSizeMb]
+    stackSizeMb: float64arr[kStackSizeMb],
+    maxCpuTimeMs: float64arr[kMaxCpuTimeMs] > 0 ?
+      float64arr[kMaxCpuTimeMs] : Infinity,
+    maxEventLoopDelayMs: float64arr[kMaxEventLoopDelayMs] > 0 ?
+      float64arr[kMaxEventLoopDelayMs] : Infinity
   };
 }
 
@@ -0,0 +1,361 @@
+'use strict';
+
+const {
+  ArrayPrototypeIndexOf,
+  ArrayPrototypePop,
+  ArrayPrototypePush,
+  ArrayPrototypeSplice,
+  MathMax,
+  NumberIsInteger,
+  Promise,
+  PromiseAll,
+  PromisePrototypeThen,
+  PromiseReject,
+  PromiseResolve,
+  SafeSet,
+  Symbol,
+} = primordials;
+
+const EventEmitter = require('events');
+const FixedQueue = require('internal/fixed_queue');
+const path = require('path');
+const { clearTimeout, setTimeout } = require('timers');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_OUT_OF_RANGE,
+    ERR_WORKER_NOT_RUNNING,
+    ERR_WORKER_PATH,
+    ERR_WORKER_POOL_CLOSED,
+    ERR_WORKER_POOL_QUEUE_FULL,
+    ERR_WORKER_UNSUPPORTED_EXTENSION,
+  },
+} = require('internal/errors');
+const { fileURLToPath, isURLInstance, pathToFileURL } = require('internal/url');
+const {
+  validateBoolean,
+  validateInteger,
+  validateNumber,
+  validateObject,
+  validateString,
+} = require('internal/validators');
+const { Worker } = require('internal/worker');
+
+const kFilename = Symbol('kFilename');
+const kMinThreads = Symbol('kMinThreads');
+const kMaxThreads = Symbol('kMaxThreads');
+const kIdleTimeout = Symbol('kIdleTimeout');
+const kMaxQueue = Symbol('kMaxQueue');
+const kResourceLimits = Symbol('kResourceLimits');
+const kQueue = Symbol('kQueue');
+const kQueueSize = Symbol('kQueueSize');
+const kNeedDrain = Symbol('kNeedDrain');
+const kThreads = Symbol('kThreads');
+const kIdleThreads = Symbol('kIdleThreads');
+const kStats = Symbol('kStats');
+const kClosed = Symbol('kClosed');
+const kDispatch = Symbol('kDispatch');
+const kSpawn = Symbol('kSpawn');
+const kRemove = Symbol('kRemove');
+
+// Code that runs inside of each pool thread. The module is loaded through
+// import(), so that both CommonJS and ES modules can provide tasks.
+const kThreadSource = `'use strict';
+const { parentPort, workerData } = require('worker_threads');
+const moduleReady = import(workerData);
+// A module that fails to load fails every task, with the error reported as
+// the task's result rather than as an unhandled rejection.
+moduleReady.catch(() => {});
+function hrnow() {
+  const hr = process.hrtime();
+  return hr[0] * 1000 + hr[1] / 1e6;
+}
+parentPort.on('message', async ({ name, task }) => {
+  const start = hrnow();
+  let failed = false;
+  let value;
+  try {
+    const namespace = await moduleReady;
+    let fn = namespace.default;
+    if (name !== undefined) {
+      fn = name in namespace ? namespace[name] :
+        fn != null ? fn[name] : undefined;
+    }
+    if (typeof fn !== 'function')
+      throw new TypeError(\`Task function "\${name}" not found\`);
+    value = await fn(task);
+  } catch (err) {
+    failed = true;
+    value = err;
+  }
+  const result = { failed, value, runTime: hrnow() - start };
+  try {
+    parentPort.postMessage(result);
+  } catch (err) {
+    result.failed = true;
+    result.value = new Error(\`Cannot clone task result: \${err.message}\`);
+    parentPort.postMessage(result);
+  }
+});
+`;
+
+function now() {
+  const hr = process.hrtime();
+  return hr[0] * 1000 + hr[1] / 1e6;
+}
+
+class PoolThread {
+  constructor(pool) {
+    this.worker = new Worker(kThreadSource, {
+      eval: true,
+      workerData: pool[kFilename],
+      resourceLimits: pool[kResourceLimits],
+    });
+    this.task = null;
+    this.idleTimer = null;
+  }
+}
+
+class Pool extends EventEmitter {
+  constructor(filename, options = {}) {
+    super();
+
+    if (isURLInstance(filename)) {
+      filename = fileURLToPath(filename);
+    } else if (typeof filename !== 'string') {
+      throw new ERR_INVALID_ARG_TYPE('filename', ['string', 'URL'], filename);
+    } else if (path.isAbsolute(filename) || /^\.\.?[\\/]/.test(filename)) {
+      filename = path.resolve(filename);
+    } else {
+      throw new ERR_WORKER_PATH(filename);
+    }
+    const ext = path.extname(filename);
+    if (ext !== '.js' && ext !== '.mjs' && ext !== '.cjs') {
+      throw new ERR_WORKER_UNSUPPORTED_EXTENSION(ext);
+    }
+
+    validateObject(options, 'options');
+    const {
+      minThreads = 0,
+      maxThreads = MathMax(require('os').cpus().length, 1),
+      idleTimeout = 1000,
+      maxQueue = Infinity,
+      resourceLimits,
+    } = options;
+    validateInteger(minThreads, 'options.minThreads', 0);
+    validateInteger(maxThreads, 'options.maxThreads', MathMax(minThreads, 1));
+    validateNumber(idleTimeout, 'options.idleTimeout');
+    if (idleTimeout < 0)
+      throw new ERR_OUT_OF_RANGE('options.idleTimeout', '>= 0', idleTimeout);
+    validateNumber(maxQueue, 'options.maxQueue');
+    if (maxQueue < 0 || (maxQueue !== Infinity && !NumberIsInteger(maxQueue))) {
+      throw new ERR_OUT_OF_RANGE(
+        'options.maxQueue', 'a non-negative integer or Infinity', maxQueue);
+    }
+    if (resourceLimits !== undefined)
+      validateObject(resourceLimits, 'options.resourceLimits');
+
+    this[kFilename] = pathToFileURL(filename).href;
+    this[kMinThreads] = minThreads;
+    this[kMaxThreads] = maxThreads;
+    this[kIdleTimeout] = idleTimeout;
+    this[kMaxQueue] = maxQueue;
+    this[kResourceLimits] = resourceLimits;
+    this[kQueue] = new FixedQueue();
+    this[kQueueSize] = 0;
+    this[kNeedDrain] = false;
+    this[kThreads] = new SafeSet();
+    this[kIdleThreads] = [];
+    this[kStats] = { completed: 0, failed: 0, runTime: 0, waitTime: 0 };
+    this[kClosed] = false;
+
+    for (let i = 0; i < minThreads; i++)
+      this[kSpawn]();
+  }
+
+  get threads() {
+    return this[kThreads].size;
+  }
+
+  get queueSize() {
+    return this[kQueueSize];
+  }
+
+  get stats() {
+    return { ...this[kStats] };
+  }
+
+  run(task, options = {}) {
+    if (this[kClosed])
+      return PromiseReject(new ERR_WORKER_POOL_CLOSED());
+    validateObject(options, 'options');
+    const { name, transferList, stats = false } = options;
+    if (name !== undefined)
+      validateString(name, 'options.name');
+    validateBoolean(stats, 'options.stats');
+
+    if (this[kQueueSize] >= this[kMaxQueue] &&
+        this[kIdleThreads].length === 0 &&
+        this[kThreads].size >= this[kMaxThreads]) {
+      // Emit 'drain' once there is capacity for new tasks again.
+      this[kNeedDrain] = true;
+      return PromiseReject(new ERR_WORKER_POOL_QUEUE_FULL());
+    }
+
+    return new Promise((resolve, reject) => {
+      this[kQueue].push({
+        name,
+        task,
+        transferList,
+        stats,
+        resolve,
+        reject,
+        queuedAt: now(),
+        waitTime: 0,
+      });
+      this[kQueueSize]++;
+      this[kDispatch]();
+    });
+  }
+
+  destroy() {
+    if (this[kClosed])
+      return PromiseResolve();
+    this[kClosed] = true;
+
+    let entry;
+    while ((entry = this[kQueue].shift()) !== null)
+      entry.reject(new ERR_WORKER_POOL_CLOSED());
+    this[kQueueSize] = 0;
+
+    const exited = [];
+    for (const thread of this[kThreads]) {
+      clearTimeout(thread.idleTimer);
+      if (thread.task !== null)
+        thread.task.reject(new ERR_WORKER_POOL_CLOSED());
+      thread.task = null;
+      ArrayPrototypePush(exited, thread.worker.terminate());
+    }
+    this[kThreads].clear();
+    this[kIdleThreads] = [];
+    return PromisePrototypeThen(PromiseAll(exited), () => {});
+  }
+
+  [kSpawn]() {
+    const thread = new PoolThread(this);
+    const { worker } = thread;
+    worker.on('message', ({ failed, value, runTime }) => {
+      const entry = thread.task;
+      // Results can still arrive after destroy() has rejected the task.
+      if (entry === null || this[kClosed])
+        return;
+      thread.task = null;
+      const stats = this[kStats];
+      stats.runTime += runTime;
+      if (failed) {
+        stats.failed++;
+        entry.reject(value);
+      } else {
+        stats.completed++;
+        entry.resolve(entry.stats ?
+          { value, runTime, waitTime: entry.waitTime } : value);
+      }
+      ArrayPrototypePush(this[kIdleThreads], thread);
+      this[kDispatch]();
+    });
+    worker.on('error', (err) => {
+      // Uncaught exceptions and resource limit violations end the thread.
+      if (thread.task !== null) {
+        this[kStats].failed++;
+        thread.task.reject(err);
+        thread.task = null;
+      }
+    });
+    worker.on('exit', (code) => {
+      if (thread.task !== null) {
+        this[kStats].failed++;
+        thread.task.reject(new ERR_WORKER_NOT_RUNNING());
+        thread.task = null;
+      }
+      this[kRemove](thread);
+      this[kDispatch]();
+    });
+    worker.unref();
+    this[kThreads].add(thread);
+    ArrayPrototypePush(this[kIdleThreads], thread);
+    return thread;
+  }
+
+  [kRemove](thread) {
+    clearTimeout(thread.idleTimer);
+    this[kThreads].delete(thread);
+    const idle = this[kIdleThreads];
+    const index = ArrayPrototypeIndexOf(idle, thread);
+    if (index !== -1)
+      ArrayPrototypeSplice(idle, index, 1);
+  }
+
+  [kDispatch]() {
+    if (this[kClosed])
+      return;
+
+    const idle = this[kIdleThreads];
+    while (this[kQueueSize] > 0) {
+      let thread = ArrayPrototypePop(idle);
+      if (thread === undefined) {
+        if (this[kThreads].size >= this[kMaxThreads])
+          break;
+        this[kSpawn]();
+        thread = ArrayPrototypePop(idle);
+      }
+      clearTimeout(thread.idleTimer);
+      thread.idleTimer = null;
+
+      const entry = this[kQueue].shift();
+      this[kQueueSize]--;
+      try {
+        thread.worker.postMessage({ name: entry.name, task: entry.task },
+                                  entry.transferList);
+      } catch (err) {
+        this[kStats].failed++;
+        entry.reject(err);
+        ArrayPrototypePush(idle, thread);
+        continue;
+      }
+      entry.waitTime = now() - entry.queuedAt;
+      this[kStats].waitTime += entry.waitTime;
+      thread.task = entry;
+      thread.worker.ref();
+    }
+
+    if (this[kNeedDrain] &&
+        (this[kQueueSize] < this[kMaxQueue] || idle.length > 0)) {
+      this[kNeedDrain] = false;
+      process.nextTick(() => this.emit('drain'));
+    }
+
+    // Threads that are still idle do not keep the event loop alive, and are
+    // shut down after `idleTimeout` unless they are needed to keep
+    // `minThreads` threads around.
+    for (let i = 0; i < idle.length; i++) {
+      const thread = idle[i];
+      thread.worker.unref();
+      if (thread.idleTimer !== null ||
+          this[kThreads].size - i <= this[kMinThreads]) {
+        continue;
+      }
+      thread.idleTimer = setTimeout(() => {
+        thread.idleTimer = null;
+        if (this[kThreads].size <= this[kMinThreads])
+          return;
+        this[kRemove](thread);
+        thread.worker.terminate();
+      }, this[kIdleTimeout]);
+      thread.idleTimer.unref();
+    }
+  }
+}
+
+module.exports = {
+  Pool,
+};
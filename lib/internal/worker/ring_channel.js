@@ -0,0 +1,304 @@
+'use strict';
+
+/* global SharedArrayBuffer */
+
+const {
+  DateNow,
+  Int32Array,
+  Promise,
+  Symbol,
+  SymbolAsyncIterator,
+} = primordials;
+
+const { AtomicsWaiter, atomicsNotify } = internalBinding('worker');
+const { byteLengthUtf8 } = internalBinding('buffer');
+const { FastBuffer } = require('internal/buffer');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_OUT_OF_RANGE,
+  },
+} = require('internal/errors');
+const { isArrayBufferView } = require('internal/util/types');
+const {
+  validateInt32,
+  validateNumber,
+  validateObject,
+} = require('internal/validators');
+const {
+  JSTransferable,
+  kClone,
+  kDeserialize
+} = require('internal/worker/js_transferable');
+
+// The SharedArrayBuffer starts with a header of Int32 fields, followed by
+// the ring of records. Each record is a 4-byte length followed by the payload,
+// padded to a multiple of 4 bytes. The payload may wrap around the end of the
+// ring, the length field never does.
+const kReadIndex = 0;
+const kWriteIndex = 1;
+// Incremented (and notified) to wake up a writer waiting for free space.
+const kReadSignal = 2;
+// Incremented (and notified) to wake up a reader waiting for records.
+const kWriteSignal = 3;
+const kReaderWaiting = 4;
+const kWriterWaiting = 5;
+const kClosed = 6;
+const kHeaderSize = 32;
+// One slot is always left empty, so that a full ring can be told apart
+// from an empty one.
+const kMinSize = 16;
+const kMaxSize = 2 ** 30;
+const kDefaultSize = 64 * 1024;
+
+const kState = Symbol('kState');
+const kBytes = Symbol('kBytes');
+const kCapacity = Symbol('kCapacity');
+
+function recordSize(length) {
+  return 4 + ((length + 3) & ~3);
+}
+
+function freeSpace(state, capacity) {
+  const readIndex = Atomics.load(state, kReadIndex);
+  const writeIndex = Atomics.load(state, kWriteIndex);
+  const used = writeIndex >= readIndex ?
+    writeIndex - readIndex : capacity - readIndex + writeIndex;
+  return capacity - 4 - used;
+}
+
+function wake(state, index) {
+  Atomics.add(state, index, 1);
+  Atomics.notify(state, index);
+  atomicsNotify(state, index);
+}
+
+// Blocks the current thread until the other side bumps `signalIndex` or the
+// deadline passes. `isReady()` is checked after announcing the waiter, so that
+// a change made just before that point is not missed. Returns false once the
+// deadline has passed.
+function waitSync(state, waitingIndex, signalIndex, isReady, deadline) {
+  const signal = Atomics.load(state, signalIndex);
+  Atomics.store(state, waitingIndex, 1);
+  let result = 'ok';
+  if (!isReady()) {
+    const timeout = deadline === Infinity ? Infinity : deadline - DateNow();
+    result = timeout > 0 ?
+      Atomics.wait(state, signalIndex, signal, timeout) : 'timed-out';
+  }
+  Atomics.store(state, waitingIndex, 0);
+  return result !== 'timed-out';
+}
+
+class RingChannel extends JSTransferable {
+  constructor(buffer) {
+    super();
+    // `buffer` is only omitted when the object is being deserialized.
+    if (buffer !== undefined)
+      this[kDeserialize]({ buffer });
+  }
+
+  get size() {
+    return this[kCapacity];
+  }
+
+  get closed() {
+    return Atomics.load(this[kState], kClosed) === 1;
+  }
+
+  write(data) {
+    const length = byteLengthOf(data);
+    const state = this[kState];
+    const capacity = this[kCapacity];
+    const total = recordSize(length);
+    if (total > capacity - 4) {
+      throw new ERR_OUT_OF_RANGE(
+        'data.byteLength', `<= ${capacity - 8}`, length);
+    }
+    if (Atomics.load(state, kClosed) === 1)
+      return false;
+
+    if (total > freeSpace(state, capacity))
+      return false;
+
+    const writeIndex = Atomics.load(state, kWriteIndex);
+    const bytes = this[kBytes];
+    const start = (writeIndex + 4) % capacity;
+    state[(kHeaderSize + writeIndex) >> 2] = length;
+    if (typeof data === 'string') {
+      if (start + length <= capacity) {
+        bytes.utf8Write(data, kHeaderSize + start, length);
+        data = null;
+      } else {
+        const encoded = new FastBuffer(length);
+        encoded.utf8Write(data, 0, length);
+        data = encoded;
+      }
+    }
+    if (data !== null) {
+      const src = new FastBuffer(data.buffer, data.byteOffset, length);
+      const head = capacity - start;
+      if (length <= head) {
+        bytes.set(src, kHeaderSize + start);
+      } else {
+        bytes.set(src.subarray(0, head), kHeaderSize + start);
+        bytes.set(src.subarray(head), kHeaderSize);
+      }
+    }
+
+    Atomics.store(state, kWriteIndex, (writeIndex + total) % capacity);
+    if (Atomics.load(state, kReaderWaiting) !== 0)
+      wake(state, kWriteSignal);
+    return true;
+  }
+
+  writeSync(data, timeout = Infinity) {
+    validateNumber(timeout, 'timeout');
+    const deadline = timeout === Infinity ? Infinity : DateNow() + timeout;
+    const state = this[kState];
+    const capacity = this[kCapacity];
+    let total;
+    const isReady = () => Atomics.load(state, kClosed) === 1 ||
+      freeSpace(state, capacity) >= total;
+    while (!this.write(data)) {
+      if (Atomics.load(state, kClosed) === 1)
+        return false;
+      total = recordSize(byteLengthOf(data));
+      if (!waitSync(state, kWriterWaiting, kReadSignal, isReady, deadline))
+        return this.write(data);
+    }
+    return true;
+  }
+
+  read() {
+    const state = this[kState];
+    const readIndex = Atomics.load(state, kReadIndex);
+    if (readIndex === Atomics.load(state, kWriteIndex))
+      return null;
+
+    const capacity = this[kCapacity];
+    const bytes = this[kBytes];
+    const length = state[(kHeaderSize + readIndex) >> 2];
+    const start = (readIndex + 4) % capacity;
+    const head = capacity - start;
+    const record = new FastBuffer(length);
+    if (length <= head) {
+      bytes.copy(record, 0, kHeaderSize + start, kHeaderSize + start + length);
+    } else {
+      bytes.copy(record, 0, kHeaderSize + start, kHeaderSize + capacity);
+      bytes.copy(record, head, kHeaderSize, kHeaderSize + length - head);
+    }
+
+    Atomics.store(state, kReadIndex,
+                  (readIndex + recordSize(length)) % capacity);
+    if (Atomics.load(state, kWriterWaiting) !== 0)
+      wake(state, kReadSignal);
+    return record;
+  }
+
+  readSync(timeout = Infinity) {
+    validateNumber(timeout, 'timeout');
+    const deadline = timeout === Infinity ? Infinity : DateNow() + timeout;
+    const state = this[kState];
+    const isReady = () => Atomics.load(state, kClosed) === 1 ||
+      Atomics.load(state, kReadIndex) !== Atomics.load(state, kWriteIndex);
+    for (;;) {
+      const record = this.read();
+      if (record !== null)
+        return record;
+      if (Atomics.load(state, kClosed) === 1)
+        return this.read();
+      if (!waitSync(state, kReaderWaiting, kWriteSignal, isReady, deadline))
+        return this.read();
+    }
+  }
+
+  close() {
+    const state = this[kState];
+    if (Atomics.exchange(state, kClosed, 1) === 1)
+      return;
+    wake(state, kWriteSignal);
+    wake(state, kReadSignal);
+  }
+
+  async *[SymbolAsyncIterator]() {
+    const state = this[kState];
+    let waiter = null;
+    let closed = false;
+    try {
+      for (;;) {
+        const record = this.read();
+        if (record !== null) {
+          yield record;
+        } else if (closed) {
+          return;
+        } else if (Atomics.load(state, kClosed) === 1) {
+          // Records written before close() are visible now, so one more
+          // pass drains the ring.
+          closed = true;
+        } else {
+          if (waiter === null)
+            waiter = new AtomicsWaiter();
+          await waitAsync(state, waiter);
+        }
+      }
+    } finally {
+      if (waiter !== null)
+        waiter.close();
+    }
+  }
+
+  [kClone]() {
+    return {
+      data: { buffer: this[kState].buffer },
+      deserializeInfo: 'internal/worker/ring_channel:RingChannel'
+    };
+  }
+
+  [kDeserialize]({ buffer }) {
+    this[kState] = new Int32Array(buffer);
+    this[kBytes] = new FastBuffer(buffer);
+    this[kCapacity] = buffer.byteLength - kHeaderSize;
+  }
+}
+
+function byteLengthOf(data) {
+  if (typeof data === 'string')
+    return byteLengthUtf8(data);
+  if (isArrayBufferView(data))
+    return data.byteLength;
+  throw new ERR_INVALID_ARG_TYPE(
+    'data', ['string', 'Buffer', 'TypedArray', 'DataView'], data);
+}
+
+// Resolves once a record may have been written or the channel was closed.
+function waitAsync(state, waiter) {
+  const signal = Atomics.load(state, kWriteSignal);
+  Atomics.store(state, kReaderWaiting, 1);
+  if (Atomics.load(state, kClosed) === 1 ||
+      Atomics.load(state, kReadIndex) !== Atomics.load(state, kWriteIndex) ||
+      !waiter.wait(state, kWriteSignal, signal)) {
+    Atomics.store(state, kReaderWaiting, 0);
+    return;
+  }
+  return new Promise((resolve) => {
+    waiter.oncomplete = () => {
+      Atomics.store(state, kReaderWaiting, 0);
+      resolve();
+    };
+  });
+}
+
+function createRingChannel(options = {}) {
+  validateObject(options, 'options');
+  const { size = kDefaultSize } = options;
+  validateInt32(size, 'options.size', kMinSize, kMaxSize);
+  // Keep records 4-byte aligned.
+  const capacity = (size + 3) & ~3;
+  return new RingChannel(new SharedArrayBuffer(kHeaderSize + capacity));
+}
+
+module.exports = {
+  RingChannel,
+  createRingChannel,
+};
@@ -243,6 +243,7 @@ function initSocketHandle(self) {
   if (self._handle) {
     self._handle[owner_symbol] = self;
     self._handle.onread = onStreamRead;
+    self._handle.ontransfer = onHandleTransfer;
     self[async_id_symbol] = getNewAsyncId(self._handle);
 
     let userBuf = self[kBuffer];
@@ -669,6 +670,36 @@ Socket.prototype._destroy = function(exception, cb) {
   }
 };
 
+// Called once the handle has been transferred to another thread through
+// `postMessage()` and closed on this side.
+function onHandleTransfer() {
+  const self = this[owner_symbol];
+  if (!self || self._handle !== this)
+    return;
+  self._handle = null;
+  if (self instanceof Server)
+    self.close();
+  else
+    self.destroy();
+}
+
+// The native handle, if it can be listed in the transferList of
+// `postMessage()`.
+function getTransferableHandle(self) {
+  const handle = self._handle;
+  if (handle instanceof TCP || handle instanceof Pipe)
+    return handle;
+  return null;
+}
+
+ObjectDefineProperty(Socket.prototype, 'transferableHandle', {
+  get: function() {
+    return getTransferableHandle(this);
+  },
+  configurable: true,
+  enumerable: true
+});
+
 Socket.prototype._getpeername = function() {
   if (!this._peername) {
     if (!this._handle || !this._handle.getpeername) {
@@ -1269,6 +1300,7 @@ function setupListenHandle(address, port, addressType, backlog, fd, flags) {
 
   this[async_id_symbol] = getNewAsyncId(this._handle);
   this._handle.onconnection = onconnection;
+  this._handle.ontransfer = onHandleTransfer;
   this._handle[owner_symbol] = this;
 
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
@@ -1377,7 +1409,7 @@ Server.prototype.listen = function(...args) {
   options = options._handle || options.handle || options;
   const flags = getFlags(options.ipv6Only);
   // (handle[, backlog][, cb]) where handle is an object with a handle
-  if (options instanceof TCP) {
+  if (options instanceof TCP || options instanceof Pipe) {
     this._handle = options;
     this[async_id_symbol] = this._handle.getAsyncId();
     listenInCluster(this, null, -1, -1, backlogFromArgs);
@@ -1476,6 +1508,14 @@ ObjectDefineProperty(Server.prototype, 'listening', {
   enumerable: true
 });
 
+ObjectDefineProperty(Server.prototype, 'transferableHandle', {
+  get: function() {
+    return getTransferableHandle(this);
+  },
+  configurable: true,
+  enumerable: true
+});
+
 Server.prototype.address = function() {
   if (this._handle && this._handle.getsockname) {
     const out = {};
@@ -36,6 +36,7 @@ const {
   kEncodingField,
   kSize,
   decode,
+  decodeArray,
   flush,
   encodings
 } = internalBinding('string_decoder');
@@ -83,6 +84,40 @@ StringDecoder.prototype.write = function write(buf) {
   return decode(this[kNativeDecoder], buf);
 };
 
+function decodeRun(nativeDecoder, run) {
+  return run.length === 1 ?
+    decode(nativeDecoder, run[0]) :
+    decodeArray(nativeDecoder, run);
+}
+
+// Returns the same as calling write() for every element of `list` and
+// joining the results, but decodes each run of binary chunks with a single
+// call into C++. Used by streams to convert their buffered chunks.
+StringDecoder.prototype[internalUtil.kStringDecoderWriteAll] =
+  function writeAll(list) {
+    let ret = '';
+    let run = [];
+    for (let i = 0; i < list.length; i++) {
+      const buf = list[i];
+      if (typeof buf === 'string') {
+        if (run.length > 0) {
+          ret += decodeRun(this[kNativeDecoder], run);
+          run = [];
+        }
+        ret += buf;
+      } else if (ArrayBufferIsView(buf)) {
+        run.push(buf);
+      } else {
+        throw new ERR_INVALID_ARG_TYPE('buf',
+                                       ['Buffer', 'TypedArray', 'DataView'],
+                                       buf);
+      }
+    }
+    if (run.length > 0)
+      ret += decodeRun(this[kNativeDecoder], run);
+    return ret;
+  };
+
 StringDecoder.prototype.end = function end(buf) {
   let ret = '';
   if (buf !== undefined)
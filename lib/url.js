@@ -43,6 +43,7 @@ const { spliceOne } = require('internal/util');
 const {
   URL,
   URLSearchParams,
+  RouteTable,
   domainToASCII,
   domainToUnicode,
   formatSymbol,
@@ -973,6 +974,7 @@ module.exports = {
   // WHATWG API
   URL,
   URLSearchParams,
+  RouteTable,
   domainToASCII,
   domainToUnicode,
 
@@ -15,11 +15,21 @@ const {
   receiveMessageOnPort
 } = require('internal/worker/io');
 
+const {
+  Pool
+} = require('internal/worker/pool');
+
+const {
+  createRingChannel
+} = require('internal/worker/ring_channel');
+
 module.exports = {
+  createRingChannel,
   isMainThread,
   MessagePort,
   MessageChannel,
   moveMessagePortToContext,
+  Pool,
   receiveMessageOnPort,
   resourceLimits,
   threadId,
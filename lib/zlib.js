@@ -24,14 +24,17 @@
 const {
   Error,
   MathMax,
+  MathMin,
   NumberIsFinite,
   NumberIsNaN,
+  NumberParseInt,
   ObjectDefineProperties,
   ObjectDefineProperty,
   ObjectFreeze,
   ObjectGetPrototypeOf,
   ObjectKeys,
   ObjectSetPrototypeOf,
+  SafeSet,
   Symbol,
 } = primordials;
 
@@ -42,6 +45,7 @@ const {
     ERR_INVALID_ARG_TYPE,
     ERR_OUT_OF_RANGE,
     ERR_ZLIB_INITIALIZATION_FAILED,
+    ERR_ZSTD_INVALID_PARAM,
   },
   hideStackFrames
 } = require('internal/errors');
@@ -53,6 +57,7 @@ const {
   isArrayBufferView,
   isAnyArrayBuffer
 } = require('internal/util/types');
+const { validateUint32 } = require('internal/validators');
 const binding = internalBinding('zlib');
 const assert = require('internal/assert');
 const finished = require('internal/streams/end-of-stream');
@@ -75,10 +80,12 @@ const {
   Z_DEFAULT_STRATEGY, Z_DEFAULT_WINDOWBITS, Z_DEFAULT_MEMLEVEL, Z_FIXED,
   // Node's compression stream modes (node_zlib_mode)
   DEFLATE, DEFLATERAW, INFLATE, INFLATERAW, GZIP, GUNZIP, UNZIP,
-  BROTLI_DECODE, BROTLI_ENCODE,
+  BROTLI_DECODE, BROTLI_ENCODE, ZSTD_COMPRESS, ZSTD_DECOMPRESS,
   // Brotli operations (~flush levels)
   BROTLI_OPERATION_PROCESS, BROTLI_OPERATION_FLUSH,
-  BROTLI_OPERATION_FINISH
+  BROTLI_OPERATION_FINISH,
+  // Zstd end directives (~flush levels)
+  ZSTD_e_continue, ZSTD_e_flush, ZSTD_e_end
 } = constants;
 
 // Translation table for return codes.
@@ -154,6 +161,175 @@ function zlibBufferOnEnd() {
     this.cb(null, buf);
 }
 
+const kMinParallelBlockSize = 32 * 1024;
+const kMaxParallelBlockSize = 1024 * 1024 * 1024;
+const kDefaultParallelBlockSize = 128 * 1024;
+const kMaxParallel = 1024;
+
+// The number of libuv threadpool threads, computed the same way as libuv
+// does it when it starts the threadpool.
+let threadpoolSize;
+function getThreadpoolSize() {
+  if (threadpoolSize === undefined) {
+    const value = process.env.UV_THREADPOOL_SIZE;
+    let size = 4;
+    if (value !== undefined) {
+      size = NumberParseInt(value, 10);
+      if (NumberIsNaN(size))
+        size = 0;
+    }
+    if (size === 0)
+      size = 1;
+    else if (size < 0 || size > kMaxParallel)
+      size = kMaxParallel;
+    threadpoolSize = size;
+  }
+  return threadpoolSize;
+}
+
+function createZlibError(message, errno, code) {
+  // eslint-disable-next-line no-restricted-syntax
+  const error = new Error(message);
+  error.errno = errno;
+  error.code = code;
+  return error;
+}
+
+// The native compression contexts take 32-bit input lengths.
+const kMaxOneShotInputLength = 2 ** 32 - 1;
+
+// Returns the input of a convenience method as an ArrayBufferView, or null
+// if it has to be handled by the stream-based implementation.
+function getOneShotInput(buffer) {
+  if (typeof buffer === 'string' || isAnyArrayBuffer(buffer))
+    buffer = Buffer.from(buffer);
+  else if (!isArrayBufferView(buffer))
+    return null;
+  if (buffer.byteLength > kMaxOneShotInputLength)
+    return null;
+  return buffer;
+}
+
+// Whether the options can be handled by the one-shot and parallel
+// compression paths, which produce the complete output in a single step.
+function canCompressOneShot(mode, opts) {
+  if (!opts)
+    return true;
+  let finishFlush = Z_FINISH;
+  if (mode === BROTLI_ENCODE)
+    finishFlush = BROTLI_OPERATION_FINISH;
+  else if (mode === ZSTD_COMPRESS)
+    finishFlush = ZSTD_e_end;
+  return !opts.info &&
+         (opts.finishFlush === undefined || opts.finishFlush === finishFlush);
+}
+
+// Compresses the complete input in a single native call, into one output
+// buffer that is sized up front from the worst-case bound of the compressor,
+// capped by maxOutputLength.
+// Runs synchronously if no callback is passed.
+function compressOneShot(mode, input, opts, callback) {
+  let job;
+  let maxOutputLength;
+  if (mode === BROTLI_ENCODE) {
+    ({ maxOutputLength } = getBaseOptions(opts, brotliDefaultOpts));
+    setBrotliInitParams(opts);
+    job = new binding.BrotliOneShotJob(mode,
+                                       BROTLI_OPERATION_FINISH,
+                                       maxOutputLength,
+                                       input);
+    if (!job.init(brotliInitParamsArray))
+      throw new ERR_ZLIB_INITIALIZATION_FAILED();
+  } else if (mode === ZSTD_COMPRESS) {
+    ({ maxOutputLength } = getBaseOptions(opts, zstdDefaultOpts));
+    const params = getZstdInitParams(opts, mode);
+    job = new binding.ZstdOneShotJob(mode, ZSTD_e_end, maxOutputLength, input);
+    if (!job.init(params))
+      throw new ERR_ZLIB_INITIALIZATION_FAILED();
+  } else {
+    ({ maxOutputLength } = getBaseOptions(opts, zlibDefaultOpts));
+    const {
+      windowBits, level, memLevel, strategy, dictionary, reuseContext
+    } = getZlibInitOptions(opts, mode);
+    job = new binding.ZlibOneShotJob(mode, Z_FINISH, maxOutputLength, input);
+    if (!job.init(windowBits, level, memLevel, strategy, dictionary,
+                  reuseContext)) {
+      throw new ERR_ZLIB_INITIALIZATION_FAILED();
+    }
+  }
+
+  if (callback === undefined) {
+    let error = null;
+    job.onerror = (message, errno, code) => {
+      error = createZlibError(message, errno, code);
+    };
+    const result = job.runSync();
+    if (error !== null)
+      throw error;
+    if (result === undefined)
+      throw new ERR_BUFFER_TOO_LARGE(maxOutputLength);
+    return result;
+  }
+
+  job.ondone = (result) => {
+    if (result === undefined)
+      callback(new ERR_BUFFER_TOO_LARGE(maxOutputLength));
+    else
+      callback(null, result);
+  };
+  job.onerror = (message, errno, code) => {
+    callback(createZlibError(message, errno, code));
+  };
+  job.run();
+}
+
+// Deflates large inputs in blocks that are compressed concurrently on the
+// threadpool. Returns false if the input or the options would not benefit
+// from, or are not supported by, the parallel mode.
+function compressParallel(mode, input, opts, callback) {
+  // Running more blocks at once than there are threadpool threads would only
+  // queue them up in front of other fs, dns and crypto work.
+  const parallel = MathMin(
+    checkRangesOrGetDefault(opts.parallel, 'options.parallel',
+                            1, kMaxParallel, 1),
+    getThreadpoolSize());
+  const blockSize = checkRangesOrGetDefault(
+    opts.blockSize, 'options.blockSize',
+    kMinParallelBlockSize, kMaxParallelBlockSize, kDefaultParallelBlockSize);
+
+  if (parallel === 1 ||
+      opts.dictionary !== undefined ||
+      input.byteLength <= blockSize) {
+    return false;
+  }
+
+  const { maxOutputLength } = getBaseOptions(opts, zlibDefaultOpts);
+  const {
+    windowBits, level, memLevel, strategy
+  } = getZlibInitOptions(opts, mode);
+
+  const job = new binding.ParallelDeflateJob(mode,
+                                             level,
+                                             windowBits,
+                                             memLevel,
+                                             strategy,
+                                             blockSize,
+                                             parallel,
+                                             maxOutputLength,
+                                             input);
+  job.ondone = (result) => {
+    if (result === undefined)
+      callback(new ERR_BUFFER_TOO_LARGE(maxOutputLength));
+    else
+      callback(null, result);
+  };
+  job.onerror = (message, errno, code) => {
+    callback(createZlibError(message, errno, code));
+  };
+  job.run();
+  return true;
+}
+
 function zlibBufferSync(engine, buffer) {
   if (typeof buffer === 'string') {
     buffer = Buffer.from(buffer);
@@ -231,14 +407,10 @@ const checkRangesOrGetDefault = hideStackFrames(
   }
 );
 
-// The base class for all Zlib-style streams.
-function ZlibBase(opts, mode, handle, { flush, finishFlush, fullFlush }) {
+// Validates the options that are shared by all engines.
+function getBaseOptions(opts, { flush, finishFlush }) {
   let chunkSize = Z_DEFAULT_CHUNK;
   let maxOutputLength = kMaxLength;
-  // The ZlibBase class is not exported to user land, the mode should only be
-  // passed in by us.
-  assert(typeof mode === 'number');
-  assert(mode >= DEFLATE && mode <= BROTLI_ENCODE);
 
   if (opts) {
     chunkSize = opts.chunkSize;
@@ -260,7 +432,24 @@ function ZlibBase(opts, mode, handle, { flush, finishFlush, fullFlush }) {
     maxOutputLength = checkRangesOrGetDefault(
       opts.maxOutputLength, 'options.maxOutputLength',
       1, kMaxLength, kMaxLength);
+  }
+
+  return { chunkSize, flush, finishFlush, maxOutputLength };
+}
 
+// The base class for all Zlib-style streams.
+function ZlibBase(opts, mode, handle, defaultOpts) {
+  // The ZlibBase class is not exported to user land, the mode should only be
+  // passed in by us.
+  assert(typeof mode === 'number');
+  assert(mode >= DEFLATE && mode <= ZSTD_DECOMPRESS);
+
+  const {
+    chunkSize, flush, finishFlush, maxOutputLength
+  } = getBaseOptions(opts, defaultOpts);
+  const { fullFlush } = defaultOpts;
+
+  if (opts) {
     if (opts.encoding || opts.objectMode || opts.writableObjectMode) {
       opts = { ...opts };
       opts.encoding = null;
@@ -605,14 +794,15 @@ const zlibDefaultOpts = {
   finishFlush: Z_FINISH,
   fullFlush: Z_FULL_FLUSH
 };
-// Base class for all streams actually backed by zlib and using zlib-specific
-// parameters.
-function Zlib(opts, mode) {
+// Validates the zlib-specific options that are passed to the native `init()`
+// methods.
+function getZlibInitOptions(opts, mode) {
   let windowBits = Z_DEFAULT_WINDOWBITS;
   let level = Z_DEFAULT_COMPRESSION;
   let memLevel = Z_DEFAULT_MEMLEVEL;
   let strategy = Z_DEFAULT_STRATEGY;
   let dictionary;
+  let reuseContext = false;
 
   if (opts) {
     // windowBits is special. On the compression side, 0 is an invalid value.
@@ -655,8 +845,26 @@ function Zlib(opts, mode) {
         );
       }
     }
+
+    if (opts.reuseContext !== undefined) {
+      if (typeof opts.reuseContext !== 'boolean') {
+        throw new ERR_INVALID_ARG_TYPE(
+          'options.reuseContext', 'boolean', opts.reuseContext);
+      }
+      reuseContext = opts.reuseContext;
+    }
   }
 
+  return { windowBits, level, memLevel, strategy, dictionary, reuseContext };
+}
+
+// Base class for all streams actually backed by zlib and using zlib-specific
+// parameters.
+function Zlib(opts, mode) {
+  const {
+    windowBits, level, memLevel, strategy, dictionary, reuseContext
+  } = getZlibInitOptions(opts, mode);
+
   const handle = new binding.Zlib(mode);
   // Ideally, we could let ZlibBase() set up _writeState. I haven't been able
   // to come up with a good solution that doesn't break our internal API,
@@ -668,7 +876,8 @@ function Zlib(opts, mode) {
                    strategy,
                    this._writeState,
                    processCallback,
-                   dictionary)) {
+                   dictionary,
+                   reuseContext)) {
     // TODO(addaleax): Sometimes we generate better error codes in C++ land,
     // e.g. ERR_BROTLI_PARAM_SET_FAILED -- it's hard to access them with
     // the current bindings setup, though.
@@ -768,9 +977,17 @@ function Unzip(opts) {
 ObjectSetPrototypeOf(Unzip.prototype, Zlib.prototype);
 ObjectSetPrototypeOf(Unzip, Zlib);
 
-function createConvenienceMethod(ctor, sync) {
+// `compressMode` is set for the compression methods, which can skip the
+// stream machinery and produce their output in a single native step.
+function createConvenienceMethod(ctor, sync, compressMode) {
   if (sync) {
     return function syncBufferWrapper(buffer, opts) {
+      if (compressMode !== undefined &&
+          canCompressOneShot(compressMode, opts)) {
+        const input = getOneShotInput(buffer);
+        if (input !== null)
+          return compressOneShot(compressMode, input, opts);
+      }
       return zlibBufferSync(new ctor(opts), buffer);
     };
   }
@@ -779,6 +996,21 @@ function createConvenienceMethod(ctor, sync) {
       callback = opts;
       opts = {};
     }
+    if (compressMode !== undefined &&
+        typeof callback === 'function' &&
+        canCompressOneShot(compressMode, opts)) {
+      const input = getOneShotInput(buffer);
+      if (input !== null) {
+        if ((compressMode === DEFLATE ||
+             compressMode === GZIP ||
+             compressMode === DEFLATERAW) &&
+            opts && opts.parallel !== undefined &&
+            compressParallel(compressMode, input, opts, callback)) {
+          return;
+        }
+        return compressOneShot(compressMode, input, opts, callback);
+      }
+    }
     return zlibBuffer(new ctor(opts), buffer, callback);
   };
 }
@@ -794,9 +1026,9 @@ const brotliDefaultOpts = {
   finishFlush: BROTLI_OPERATION_FINISH,
   fullFlush: BROTLI_OPERATION_FLUSH
 };
-function Brotli(opts, mode) {
-  assert(mode === BROTLI_DECODE || mode === BROTLI_ENCODE);
-
+// Validates `opts.params` and stores them in `brotliInitParamsArray`, which is
+// passed to the native `init()` methods.
+function setBrotliInitParams(opts) {
   brotliInitParamsArray.fill(-1);
   if (opts && opts.params) {
     for (const origKey of ObjectKeys(opts.params)) {
@@ -814,6 +1046,12 @@ function Brotli(opts, mode) {
       brotliInitParamsArray[key] = value;
     }
   }
+}
+
+function Brotli(opts, mode) {
+  assert(mode === BROTLI_DECODE || mode === BROTLI_ENCODE);
+
+  setBrotliInitParams(opts);
 
   const handle = mode === BROTLI_DECODE ?
     new binding.BrotliDecoder(mode) : new binding.BrotliEncoder(mode);
@@ -846,6 +1084,82 @@ function BrotliDecompress(opts) {
 ObjectSetPrototypeOf(BrotliDecompress.prototype, Brotli.prototype);
 ObjectSetPrototypeOf(BrotliDecompress, Brotli);
 
+const zstdDefaultOpts = {
+  flush: ZSTD_e_continue,
+  finishFlush: ZSTD_e_end,
+  fullFlush: ZSTD_e_flush
+};
+
+// The zstd parameter keys are sparse, so valid ones are looked up by value.
+const zstdCompressParams = new SafeSet();
+const zstdDecompressParams = new SafeSet();
+for (const key of ObjectKeys(constants)) {
+  if (key.startsWith('ZSTD_c_'))
+    zstdCompressParams.add(constants[key]);
+  else if (key.startsWith('ZSTD_d_'))
+    zstdDecompressParams.add(constants[key]);
+}
+
+// Validates `opts.params` and returns them as (key, value) pairs, which is
+// the format the native `init()` methods expect.
+function getZstdInitParams(opts, mode) {
+  const validParams =
+    mode === ZSTD_COMPRESS ? zstdCompressParams : zstdDecompressParams;
+  const keys = opts && opts.params ? ObjectKeys(opts.params) : [];
+  const params = new Int32Array(keys.length * 2);
+  for (let i = 0; i < keys.length; i++) {
+    const origKey = keys[i];
+    const key = +origKey;
+    if (!validParams.has(key))
+      throw new ERR_ZSTD_INVALID_PARAM(origKey);
+
+    const value = opts.params[origKey];
+    if (typeof value !== 'number' && typeof value !== 'boolean') {
+      throw new ERR_INVALID_ARG_TYPE('options.params[key]',
+                                     'number', opts.params[origKey]);
+    }
+    params[i * 2] = key;
+    params[i * 2 + 1] = value;
+  }
+  return params;
+}
+
+function Zstd(opts, mode) {
+  assert(mode === ZSTD_COMPRESS || mode === ZSTD_DECOMPRESS);
+
+  const params = getZstdInitParams(opts, mode);
+
+  const handle = mode === ZSTD_COMPRESS ?
+    new binding.ZstdCompress(mode) : new binding.ZstdDecompress(mode);
+
+  this._writeState = new Uint32Array(2);
+  if (!handle.init(params,
+                   this._writeState,
+                   processCallback)) {
+    throw new ERR_ZLIB_INITIALIZATION_FAILED();
+  }
+
+  ZlibBase.call(this, opts, mode, handle, zstdDefaultOpts);
+}
+ObjectSetPrototypeOf(Zstd.prototype, Zlib.prototype);
+ObjectSetPrototypeOf(Zstd, Zlib);
+
+function ZstdCompress(opts) {
+  if (!(this instanceof ZstdCompress))
+    return new ZstdCompress(opts);
+  Zstd.call(this, opts, ZSTD_COMPRESS);
+}
+ObjectSetPrototypeOf(ZstdCompress.prototype, Zstd.prototype);
+ObjectSetPrototypeOf(ZstdCompress, Zstd);
+
+function ZstdDecompress(opts) {
+  if (!(this instanceof ZstdDecompress))
+    return new ZstdDecompress(opts);
+  Zstd.call(this, opts, ZSTD_DECOMPRESS);
+}
+ObjectSetPrototypeOf(ZstdDecompress.prototype, Zstd.prototype);
+ObjectSetPrototypeOf(ZstdDecompress, Zstd);
+
 
 function createProperty(ctor) {
   return {
@@ -864,6 +1178,25 @@ ObjectDefineProperty(binding.Zlib.prototype, 'jsref', {
   set(v) { return this[owner_symbol] = v; }
 });
 
+function validateChecksumData(data) {
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'data', ['string', 'Buffer', 'TypedArray', 'DataView'], data);
+  }
+}
+
+function crc32(data, initial = 0) {
+  validateChecksumData(data);
+  validateUint32(initial, 'initial');
+  return binding.crc32(data, initial);
+}
+
+function adler32(data, initial = 1) {
+  validateChecksumData(data);
+  validateUint32(initial, 'initial');
+  return binding.adler32(data, initial);
+}
+
 module.exports = {
   Deflate,
   Inflate,
@@ -874,15 +1207,17 @@ module.exports = {
   Unzip,
   BrotliCompress,
   BrotliDecompress,
+  ZstdCompress,
+  ZstdDecompress,
 
   // Convenience methods.
   // compress/decompress a string or buffer in one step.
-  deflate: createConvenienceMethod(Deflate, false),
-  deflateSync: createConvenienceMethod(Deflate, true),
-  gzip: createConvenienceMethod(Gzip, false),
-  gzipSync: createConvenienceMethod(Gzip, true),
-  deflateRaw: createConvenienceMethod(DeflateRaw, false),
-  deflateRawSync: createConvenienceMethod(DeflateRaw, true),
+  deflate: createConvenienceMethod(Deflate, false, DEFLATE),
+  deflateSync: createConvenienceMethod(Deflate, true, DEFLATE),
+  gzip: createConvenienceMethod(Gzip, false, GZIP),
+  gzipSync: createConvenienceMethod(Gzip, true, GZIP),
+  deflateRaw: createConvenienceMethod(DeflateRaw, false, DEFLATERAW),
+  deflateRawSync: createConvenienceMethod(DeflateRaw, true, DEFLATERAW),
   unzip: createConvenienceMethod(Unzip, false),
   unzipSync: createConvenienceMethod(Unzip, true),
   inflate: createConvenienceMethod(Inflate, false),
@@ -891,10 +1226,20 @@ module.exports = {
   gunzipSync: createConvenienceMethod(Gunzip, true),
   inflateRaw: createConvenienceMethod(InflateRaw, false),
   inflateRawSync: createConvenienceMethod(InflateRaw, true),
-  brotliCompress: createConvenienceMethod(BrotliCompress, false),
-  brotliCompressSync: createConvenienceMethod(BrotliCompress, true),
+  brotliCompress:
+    createConvenienceMethod(BrotliCompress, false, BROTLI_ENCODE),
+  brotliCompressSync:
+    createConvenienceMethod(BrotliCompress, true, BROTLI_ENCODE),
   brotliDecompress: createConvenienceMethod(BrotliDecompress, false),
   brotliDecompressSync: createConvenienceMethod(BrotliDecompress, true),
+  zstdCompress: createConvenienceMethod(ZstdCompress, false, ZSTD_COMPRESS),
+  zstdCompressSync: createConvenienceMethod(ZstdCompress, true, ZSTD_COMPRESS),
+  zstdDecompress: createConvenienceMethod(ZstdDecompress, false),
+  zstdDecompressSync: createConvenienceMethod(ZstdDecompress, true),
+
+  // Checksums.
+  crc32,
+  adler32,
 };
 
 ObjectDefineProperties(module.exports, {
@@ -907,6 +1252,8 @@ ObjectDefineProperties(module.exports, {
   createUnzip: createProperty(Unzip),
   createBrotliCompress: createProperty(BrotliCompress),
   createBrotliDecompress: createProperty(BrotliDecompress),
+  createZstdCompress: createProperty(ZstdCompress),
+  createZstdDecompress: createProperty(ZstdDecompress),
   constants: {
     configurable: false,
     enumerable: true,
@@ -922,7 +1269,7 @@ ObjectDefineProperties(module.exports, {
 // These should be considered deprecated
 // expose all the zlib constants
 for (const bkey of ObjectKeys(constants)) {
-  if (bkey.startsWith('BROTLI')) continue;
+  if (bkey.startsWith('BROTLI') || bkey.startsWith('ZSTD')) continue;
   ObjectDefineProperty(module.exports, bkey, {
     enumerable: false, value: constants[bkey], writable: false
   });
@@ -14,6 +14,7 @@
     'force_dynamic_crt%': 0,
     'node_module_version%': '',
     'node_shared_brotli%': 'false',
+    'node_shared_zstd%': 'false',
     'node_shared_zlib%': 'false',
     'node_shared_http_parser%': 'false',
     'node_shared_cares%': 'false',
@@ -221,6 +222,8 @@
       'lib/internal/worker.js',
       'lib/internal/worker/io.js',
       'lib/internal/worker/js_transferable.js',
+      'lib/internal/worker/pool.js',
+      'lib/internal/worker/ring_channel.js',
       'lib/internal/watchdog.js',
       'lib/internal/streams/lazy_transform.js',
       'lib/internal/streams/async_iterator.js',
@@ -183,9 +183,226 @@ void DebuggingArrayBufferAllocator::RegisterPointerInternal(void* data,
   allocations_[data] = size;
 }
 
+namespace {
+
+// Size classes are the powers of two from 16 bytes up to 8 KB, the size of
+// the pool used by Buffer.allocUnsafe(). Larger allocations use malloc().
+// Blocks are carved out of chunks that are never returned to the system, so
+// memory that is freed by one thread (or by an isolate that has been torn
+// down) can be reused by all others.
+constexpr size_t kArenaMinBlockSize = 16;
+constexpr size_t kArenaClassCount = 10;
+constexpr size_t kArenaMaxBlockSize =
+    kArenaMinBlockSize << (kArenaClassCount - 1);
+constexpr size_t kArenaChunkSize = 256 * 1024;
+// Each thread keeps up to this many bytes per size class for itself, so that
+// most allocations and frees do not need to take a lock.
+constexpr size_t kArenaThreadCacheSize = 64 * 1024;
+
+struct ArenaBlock {
+  ArenaBlock* next;
+};
+
+class ArrayBufferArena {
+ public:
+  static inline bool Handles(size_t size) {
+    return size > 0 && size <= kArenaMaxBlockSize;
+  }
+
+  static inline size_t ClassOf(size_t size) {
+    size_t cls = 0;
+    while ((kArenaMinBlockSize << cls) < size) cls++;
+    return cls;
+  }
+
+  static void* Allocate(size_t size);
+  static void Free(void* data, size_t size);
+
+ private:
+  struct SizeClass {
+    Mutex mutex;
+    ArenaBlock* head = nullptr;
+  };
+
+  struct ThreadCache {
+    ArenaBlock* head[kArenaClassCount] = {};
+    size_t count[kArenaClassCount] = {};
+  };
+
+  // Returns the cached blocks to the shared lists when a thread exits.
+  struct ThreadCacheHolder {
+    ~ThreadCacheHolder();
+
+    ThreadCache cache;
+  };
+
+  static inline size_t CacheLimit(size_t cls) {
+    return kArenaThreadCacheSize / (kArenaMinBlockSize << cls);
+  }
+
+  // Moves up to `max_count` blocks from the shared list into `cache`.
+  static void Refill(ThreadCache* cache, size_t cls, size_t max_count);
+  // Moves up to `max_count` blocks from `cache` back into the shared list.
+  static void Flush(ThreadCache* cache, size_t cls, size_t max_count);
+  static ThreadCache* GetThreadCache();
+
+  static SizeClass classes_[kArenaClassCount];
+  // Set once the calling thread's cache has been destroyed during thread
+  // exit. Later calls on that thread go to the shared lists directly.
+  static thread_local bool thread_cache_destroyed_;
+};
+
+ArrayBufferArena::SizeClass
+    ArrayBufferArena::classes_[kArenaClassCount];
+thread_local bool ArrayBufferArena::thread_cache_destroyed_ = false;
+
+ArrayBufferArena::ThreadCacheHolder::~ThreadCacheHolder() {
+  for (size_t cls = 0; cls < kArenaClassCount; cls++)
+    Flush(&cache, cls, cache.count[cls]);
+  thread_cache_destroyed_ = true;
+}
+
+ArrayBufferArena::ThreadCache* ArrayBufferArena::GetThreadCache() {
+  if (thread_cache_destroyed_) return nullptr;
+  static thread_local ThreadCacheHolder holder;
+  return &holder.cache;
+}
+
+void ArrayBufferArena::Refill(ThreadCache* cache,
+                              size_t cls,
+                              size_t max_count) {
+  SizeClass* size_class = &classes_[cls];
+  Mutex::ScopedLock lock(size_class->mutex);
+  if (size_class->head == nullptr) {
+    char* chunk = UncheckedMalloc<char>(kArenaChunkSize);
+    if (chunk == nullptr) return;
+    const size_t block_size = kArenaMinBlockSize << cls;
+    for (size_t offset = 0; offset < kArenaChunkSize; offset += block_size) {
+      ArenaBlock* block = reinterpret_cast<ArenaBlock*>(chunk + offset);
+      block->next = size_class->head;
+      size_class->head = block;
+    }
+  }
+  while (size_class->head != nullptr && cache->count[cls] < max_count) {
+    ArenaBlock* block = size_class->head;
+    size_class->head = block->next;
+    block->next = cache->head[cls];
+    cache->head[cls] = block;
+    cache->count[cls]++;
+  }
+}
+
+void ArrayBufferArena::Flush(ThreadCache* cache,
+                             size_t cls,
+                             size_t max_count) {
+  if (max_count == 0) return;
+  SizeClass* size_class = &classes_[cls];
+  Mutex::ScopedLock lock(size_class->mutex);
+  for (size_t i = 0; i < max_count && cache->head[cls] != nullptr; i++) {
+    ArenaBlock* block = cache->head[cls];
+    cache->head[cls] = block->next;
+    cache->count[cls]--;
+    block->next = size_class->head;
+    size_class->head = block;
+  }
+}
+
+void* ArrayBufferArena::Allocate(size_t size) {
+  const size_t cls = ClassOf(size);
+  ThreadCache* cache = GetThreadCache();
+  if (cache == nullptr) {
+    ThreadCache single;
+    Refill(&single, cls, 1);
+    return single.head[cls];
+  }
+  if (cache->head[cls] == nullptr) {
+    Refill(cache, cls, CacheLimit(cls) / 2);
+    if (cache->head[cls] == nullptr) return nullptr;
+  }
+  ArenaBlock* block = cache->head[cls];
+  cache->head[cls] = block->next;
+  cache->count[cls]--;
+  return block;
+}
+
+void ArrayBufferArena::Free(void* data, size_t size) {
+  const size_t cls = ClassOf(size);
+  ArenaBlock* block = static_cast<ArenaBlock*>(data);
+  ThreadCache* cache = GetThreadCache();
+  if (cache == nullptr) {
+    SizeClass* size_class = &classes_[cls];
+    Mutex::ScopedLock lock(size_class->mutex);
+    block->next = size_class->head;
+    size_class->head = block;
+    return;
+  }
+  block->next = cache->head[cls];
+  cache->head[cls] = block;
+  if (++cache->count[cls] > CacheLimit(cls))
+    Flush(cache, cls, CacheLimit(cls) / 2);
+}
+
+}  // anonymous namespace
+
+void* ArenaArrayBufferAllocator::Allocate(size_t size) {
+  if (!ArrayBufferArena::Handles(size))
+    return NodeArrayBufferAllocator::Allocate(size);
+  void* ret = ArrayBufferArena::Allocate(size);
+  if (LIKELY(ret != nullptr)) {
+    if (zero_fill_field()[0] || per_process::cli_options->zero_fill_all_buffers)
+      memset(ret, 0, size);
+    // Only used for the per-isolate accounting here.
+    NodeArrayBufferAllocator::RegisterPointer(ret, size);
+  }
+  return ret;
+}
+
+void* ArenaArrayBufferAllocator::AllocateUninitialized(size_t size) {
+  if (!ArrayBufferArena::Handles(size))
+    return NodeArrayBufferAllocator::AllocateUninitialized(size);
+  void* ret = ArrayBufferArena::Allocate(size);
+  if (LIKELY(ret != nullptr))
+    NodeArrayBufferAllocator::RegisterPointer(ret, size);
+  return ret;
+}
+
+void ArenaArrayBufferAllocator::Free(void* data, size_t size) {
+  if (!ArrayBufferArena::Handles(size))
+    return NodeArrayBufferAllocator::Free(data, size);
+  NodeArrayBufferAllocator::UnregisterPointer(data, size);
+  ArrayBufferArena::Free(data, size);
+}
+
+void* ArenaArrayBufferAllocator::Reallocate(
+    void* data, size_t old_size, size_t size) {
+  const bool old_in_arena = ArrayBufferArena::Handles(old_size);
+  const bool new_in_arena = ArrayBufferArena::Handles(size);
+  if (!old_in_arena && !new_in_arena)
+    return NodeArrayBufferAllocator::Reallocate(data, old_size, size);
+
+  if (old_in_arena && new_in_arena &&
+      ArrayBufferArena::ClassOf(old_size) == ArrayBufferArena::ClassOf(size)) {
+    NodeArrayBufferAllocator::UnregisterPointer(data, old_size);
+    NodeArrayBufferAllocator::RegisterPointer(data, size);
+    return data;
+  }
+
+  if (size == 0) {
+    Free(data, old_size);
+    return nullptr;
+  }
+  void* ret = AllocateUninitialized(size);
+  if (ret == nullptr) return nullptr;
+  memcpy(ret, data, std::min(old_size, size));
+  Free(data, old_size);
+  return ret;
+}
+
 std::unique_ptr<ArrayBufferAllocator> ArrayBufferAllocator::Create(bool debug) {
   if (debug || per_process::cli_options->debug_arraybuffer_allocations)
     return std::make_unique<DebuggingArrayBufferAllocator>();
+  else if (per_process::cli_options->experimental_arraybuffer_arena)
+    return std::make_unique<ArenaArrayBufferAllocator>();
   else
     return std::make_unique<NodeArrayBufferAllocator>();
 }
@@ -8,6 +8,10 @@
 #include "tcp_wrap.h"
 #include "util-inl.h"
 
+#ifndef _WIN32
+#include <fcntl.h>  // fcntl()
+#endif
+
 namespace node {
 
 using v8::Boolean;
@@ -18,6 +22,18 @@ using v8::Local;
 using v8::Object;
 using v8::Value;
 
+namespace {
+
+inline int OpenHandle(uv_tcp_t* handle, int fd) {
+  return uv_tcp_open(handle, fd);
+}
+
+inline int OpenHandle(uv_pipe_t* handle, int fd) {
+  return uv_pipe_open(handle, fd);
+}
+
+}  // anonymous namespace
+
 
 template <typename WrapType, typename UVType>
 ConnectionWrap<WrapType, UVType>::ConnectionWrap(Environment* env,
@@ -111,6 +127,115 @@ void ConnectionWrap<WrapType, UVType>::AfterConnect(uv_connect_t* req,
   req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
 }
 
+
+template <typename WrapType, typename UVType>
+BaseObject::TransferMode
+ConnectionWrap<WrapType, UVType>::GetTransferMode() const {
+#ifdef _WIN32
+  // Sockets are bound to the completion port of the event loop that first
+  // used them, so they cannot be moved to another thread's event loop.
+  return TransferMode::kUntransferable;
+#else
+  const uv_stream_t* stream = reinterpret_cast<const uv_stream_t*>(&handle_);
+  uv_os_fd_t fd;
+  if (IsHandleClosing() ||
+      uv_fileno(reinterpret_cast<const uv_handle_t*>(stream), &fd) != 0) {
+    return TransferMode::kUntransferable;
+  }
+  // IPC pipes carry state that is tied to the current process object.
+  if (stream->type == UV_NAMED_PIPE &&
+      reinterpret_cast<const uv_pipe_t*>(stream)->ipc) {
+    return TransferMode::kUntransferable;
+  }
+  // Servers may be listening, but sockets must not be reading or have
+  // pending writes, so that no data is lost on this side.
+  const bool is_server = provider_type() == PROVIDER_TCPSERVERWRAP ||
+                         provider_type() == PROVIDER_PIPESERVERWRAP;
+  if (!is_server &&
+      (uv_is_active(reinterpret_cast<const uv_handle_t*>(stream)) ||
+       stream->write_queue_size != 0)) {
+    return TransferMode::kUntransferable;
+  }
+  return TransferMode::kTransferable;
+#endif
+}
+
+
+template <typename WrapType, typename UVType>
+std::unique_ptr<worker::TransferData>
+ConnectionWrap<WrapType, UVType>::TransferForMessaging() {
+  CHECK_NE(GetTransferMode(), TransferMode::kUntransferable);
+#ifdef _WIN32
+  UNREACHABLE();
+#else
+  uv_os_fd_t current_fd;
+  CHECK_EQ(uv_fileno(GetHandle(), &current_fd), 0);
+  int fd = fcntl(current_fd, F_DUPFD_CLOEXEC, 0);
+  if (fd == -1) {
+    env()->ThrowErrnoException(errno, "dup");
+    return {};
+  }
+  const bool is_server = provider_type() == PROVIDER_TCPSERVERWRAP ||
+                         provider_type() == PROVIDER_PIPESERVERWRAP;
+
+  // Let the JS owner know that the handle is gone once it has been closed.
+  Local<Value> ontransfer;
+  if (!object()->Get(env()->context(),
+                     env()->ontransfer_string()).ToLocal(&ontransfer)) {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+    uv_fs_req_cleanup(&close_req);
+    return {};
+  }
+  Close(ontransfer);
+  return std::make_unique<TransferData>(fd, is_server);
+#endif
+}
+
+
+template <typename WrapType, typename UVType>
+ConnectionWrap<WrapType, UVType>::TransferData::TransferData(int fd,
+                                                             bool is_server)
+    : fd_(fd), is_server_(is_server) {}
+
+
+template <typename WrapType, typename UVType>
+ConnectionWrap<WrapType, UVType>::TransferData::~TransferData() {
+  if (fd_ >= 0) {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd_, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  }
+}
+
+
+template <typename WrapType, typename UVType>
+BaseObjectPtr<BaseObject>
+ConnectionWrap<WrapType, UVType>::TransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<worker::TransferData> self) {
+  // There is no parent wrap on this thread; the MessagePort that received
+  // the handle is the resource currently executing.
+  Local<Object> obj;
+  if (!WrapType::Instantiate(env,
+                             env->execution_async_id(),
+                             is_server_ ? WrapType::SERVER : WrapType::SOCKET)
+           .ToLocal(&obj)) {
+    return {};
+  }
+  WrapType* wrap = Unwrap<WrapType>(obj);
+  CHECK_NOT_NULL(wrap);
+
+  int err = OpenHandle(&wrap->handle_, fd_);
+  if (err != 0) {
+    env->ThrowUVException(err, "open");
+    return {};
+  }
+  fd_ = -1;
+  return BaseObjectPtr<BaseObject> { wrap };
+}
+
 template ConnectionWrap<PipeWrap, uv_pipe_t>::ConnectionWrap(
     Environment* env,
     Local<Object> object,
@@ -133,5 +258,17 @@ template void ConnectionWrap<PipeWrap, uv_pipe_t>::AfterConnect(
 template void ConnectionWrap<TCPWrap, uv_tcp_t>::AfterConnect(
     uv_connect_t* handle, int status);
 
+template BaseObject::TransferMode
+ConnectionWrap<PipeWrap, uv_pipe_t>::GetTransferMode() const;
+
+template BaseObject::TransferMode
+ConnectionWrap<TCPWrap, uv_tcp_t>::GetTransferMode() const;
+
+template std::unique_ptr<worker::TransferData>
+ConnectionWrap<PipeWrap, uv_pipe_t>::TransferForMessaging();
+
+template std::unique_ptr<worker::TransferData>
+ConnectionWrap<TCPWrap, uv_tcp_t>::TransferForMessaging();
+
 
 }  // namespace node
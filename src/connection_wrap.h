@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "node_messaging.h"
 #include "stream_wrap.h"
 
 namespace node {
@@ -15,6 +16,31 @@ class ConnectionWrap : public LibuvStreamWrap {
   static void OnConnection(uv_stream_t* handle, int status);
   static void AfterConnect(uv_connect_t* req, int status);
 
+  // Connected sockets and servers can be moved to another thread. The
+  // receiving side opens a new handle for a duplicate of the file descriptor
+  // on its own event loop, and the handle on this side is closed.
+  TransferMode GetTransferMode() const override;
+  std::unique_ptr<worker::TransferData> TransferForMessaging() override;
+
+  class TransferData : public worker::TransferData {
+   public:
+    TransferData(int fd, bool is_server);
+    ~TransferData();
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<worker::TransferData> self) override;
+
+    SET_NO_MEMORY_INFO()
+    SET_MEMORY_INFO_NAME(ConnectionWrapTransferData)
+    SET_SELF_SIZE(TransferData)
+
+   private:
+    int fd_;
+    bool is_server_;
+  };
+
  protected:
   ConnectionWrap(Environment* env,
                  v8::Local<v8::Object> object,
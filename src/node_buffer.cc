@@ -509,6 +509,102 @@ void StringSlice(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// A one-byte string resource that points into the memory of an ArrayBuffer
+// instead of owning a copy of it. The backing store stays alive for as long
+// as the string does. The memory is already accounted for by the
+// ArrayBuffer, so unlike ExternString no external memory is reported.
+class ExternalBufferString : public String::ExternalOneByteStringResource {
+ public:
+  ExternalBufferString(std::shared_ptr<BackingStore> backing_store,
+                       const char* data,
+                       size_t length)
+      : backing_store_(std::move(backing_store)),
+        data_(data),
+        length_(length) {}
+
+  const char* data() const override { return data_; }
+  size_t length() const override { return length_; }
+
+ private:
+  std::shared_ptr<BackingStore> backing_store_;
+  const char* data_;
+  size_t length_;
+};
+
+// Ranges shorter than this are copied as usual; creating and later
+// finalizing an external string costs more than copying a few kilobytes.
+constexpr size_t kMinExternalBufferStringLength = 16 * 1024;
+
+bool IsAscii(const char* data, size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if (word & 0x8080808080808080ull)
+      return false;
+  }
+  for (; i < length; i++) {
+    if (data[i] & 0x80)
+      return false;
+  }
+  return true;
+}
+
+// str = externalStringSlice(buffer, start, end, asciiOnly)
+// Returns a latin1 string that shares the memory of `buffer`. If `asciiOnly`
+// is set and the range contains non-ASCII bytes, returns undefined instead.
+void ExternalStringSlice(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  THROW_AND_RETURN_UNLESS_BUFFER(env, args[0]);
+  CHECK(args[3]->IsBoolean());
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  const size_t byte_length = view->ByteLength();
+
+  size_t start = 0;
+  size_t end = 0;
+  THROW_AND_RETURN_IF_OOB(ParseArrayIndex(env, args[1], 0, &start));
+  THROW_AND_RETURN_IF_OOB(ParseArrayIndex(env, args[2], byte_length, &end));
+  if (end < start) end = start;
+  THROW_AND_RETURN_IF_OOB(Just(end <= byte_length));
+  const size_t length = end - start;
+
+  if (length == 0)
+    return args.GetReturnValue().SetEmptyString();
+
+  std::shared_ptr<BackingStore> backing_store =
+      view->Buffer()->GetBackingStore();
+  const char* data = static_cast<const char*>(backing_store->Data()) +
+                     view->ByteOffset() + start;
+
+  if (args[3]->IsTrue() && !IsAscii(data, length))
+    return;
+
+  if (length < kMinExternalBufferStringLength) {
+    Local<Value> error;
+    MaybeLocal<Value> ret =
+        StringBytes::Encode(isolate, data, length, LATIN1, &error);
+    if (ret.IsEmpty()) {
+      CHECK(!error.IsEmpty());
+      isolate->ThrowException(error);
+      return;
+    }
+    return args.GetReturnValue().Set(ret.ToLocalChecked());
+  }
+
+  ExternalBufferString* resource =
+      new ExternalBufferString(std::move(backing_store), data, length);
+  Local<String> str;
+  if (!String::NewExternalOneByte(isolate, resource).ToLocal(&str)) {
+    delete resource;
+    isolate->ThrowException(ERR_STRING_TOO_LONG(isolate));
+    return;
+  }
+  args.GetReturnValue().Set(str);
+}
+
+
 // bytesCopied = copy(buffer, target[, targetStart][, sourceStart][, sourceEnd])
 void Copy(const FunctionCallbackInfo<Value> &args) {
   Environment* env = Environment::GetCurrent(args);
@@ -548,6 +644,43 @@ void Copy(const FunctionCallbackInfo<Value> &args) {
 }
 
 
+// bytesCopied = concat(list, count, target)
+// Copies the first `count` elements of `list` into `target` back to back,
+// until `target` is full. Returns `-1 - i` if `list[i]` is not a Uint8Array,
+// so that the caller can throw an error that refers to that element.
+void Concat(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint8Array());
+  Local<Object> list = args[0].As<Object>();
+  const uint32_t count = args[1].As<Uint32>()->Value();
+  SPREAD_BUFFER_ARG(args[2], target);
+
+  size_t pos = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> item;
+    if (!list->Get(context, i).ToLocal(&item))
+      return;
+    if (!item->IsUint8Array())
+      return args.GetReturnValue().Set(-1 - static_cast<double>(i));
+
+    // CopyContents() also works for small on-heap typed arrays without
+    // forcing V8 to move them to an off-heap backing store.
+    const size_t to_copy =
+        std::min(item.As<Uint8Array>()->ByteLength(), target_length - pos);
+    if (to_copy > 0) {
+      item.As<Uint8Array>()->CopyContents(target_data + pos, to_copy);
+      pos += to_copy;
+    }
+  }
+
+  args.GetReturnValue().Set(static_cast<double>(pos));
+}
+
+
 void Fill(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Local<Context> ctx = env->context();
@@ -1129,6 +1262,7 @@ void Initialize(Local<Object> target,
 
   env->SetMethodNoSideEffect(target, "byteLengthUtf8", ByteLengthUtf8);
   env->SetMethod(target, "copy", Copy);
+  env->SetMethod(target, "concat", Concat);
   env->SetMethodNoSideEffect(target, "compare", Compare);
   env->SetMethodNoSideEffect(target, "compareOffset", CompareOffset);
   env->SetMethod(target, "fill", Fill);
@@ -1157,6 +1291,8 @@ void Initialize(Local<Object> target,
   env->SetMethodNoSideEffect(target, "hexSlice", StringSlice<HEX>);
   env->SetMethodNoSideEffect(target, "ucs2Slice", StringSlice<UCS2>);
   env->SetMethodNoSideEffect(target, "utf8Slice", StringSlice<UTF8>);
+  env->SetMethodNoSideEffect(target, "externalStringSlice",
+                             ExternalStringSlice);
 
   env->SetMethod(target, "asciiWrite", StringWrite<ASCII>);
   env->SetMethod(target, "base64Write", StringWrite<BASE64>);
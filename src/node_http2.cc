@@ -26,6 +26,7 @@ using v8::EscapableHandleScope;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Isolate;
@@ -46,6 +47,11 @@ namespace {
 
 const char zero_bytes_256[256] = {};
 
+// Opaque data of the PING frames used for window autotuning. ACKs are
+// matched by their position among the outstanding PINGs, not by this payload,
+// so a user PING that happens to carry the same data is not mistaken for one.
+const uint8_t kBdpPingPayload[8] = { 'n', 'o', 'd', 'e', 'b', 'd', 'p', 0 };
+
 bool HasHttp2Observer(Environment* env) {
   AliasedUint32Array& observers = env->performance_state()->observers;
   return observers[performance::NODE_PERFORMANCE_ENTRY_TYPE_HTTP2] != 0;
@@ -199,6 +205,15 @@ Http2Options::Http2Options(Http2State* http2_state, SessionType type) {
         option,
         static_cast<size_t>(buffer[IDX_OPTIONS_MAX_SETTINGS]));
   }
+
+  // When set, the local flow control windows are grown automatically up to
+  // this size, based on an estimate of the bandwidth-delay product of the
+  // connection. See Http2Session::UpdateWindowAutotuning().
+  if (flags & (1 << IDX_OPTIONS_MAX_AUTOTUNED_WINDOW_SIZE)) {
+    set_max_autotuned_window_size(
+        std::min(buffer.GetValue(IDX_OPTIONS_MAX_AUTOTUNED_WINDOW_SIZE),
+                 MAX_INITIAL_WINDOW_SIZE));
+  }
 }
 
 #define GRABSETTING(entries, count, name)                                      \
@@ -435,6 +450,8 @@ Http2Session::Callbacks::Callbacks(bool kHasGetPaddingCallback) {
     callbacks_, OnInvalidFrame);
   nghttp2_session_callbacks_set_on_frame_send_callback(
     callbacks_, OnFrameSent);
+  nghttp2_session_callbacks_set_data_source_read_length_callback(
+    callbacks_, OnDataSourceReadLength);
 
   if (kHasGetPaddingCallback) {
     nghttp2_session_callbacks_set_select_padding_callback(
@@ -481,6 +498,7 @@ Http2Session::Http2Session(Http2State* http2_state,
 
   max_outstanding_pings_ = opts.max_outstanding_pings();
   max_outstanding_settings_ = opts.max_outstanding_settings();
+  max_autotuned_window_size_ = opts.max_autotuned_window_size();
 
   padding_strategy_ = opts.padding_strategy();
 
@@ -518,8 +536,9 @@ Http2Session::Http2Session(Http2State* http2_state,
 Http2Session::~Http2Session() {
   CHECK(!is_in_scope());
   Debug(this, "freeing nghttp2 session");
-  // Explicitly reset session_ so the subsequent
-  // current_nghttp2_memory_ check passes.
+  // Release the cached header strings and explicitly reset session_ so the
+  // subsequent current_nghttp2_memory_ check passes.
+  header_string_cache_.Clear();
   session_.reset();
   CHECK_EQ(current_nghttp2_memory_, 0);
 }
@@ -534,6 +553,7 @@ void Http2Session::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("pending_rst_streams",
                               pending_rst_streams_.size() * sizeof(int32_t));
   tracker->TrackFieldWithSize("nghttp2_memory", current_nghttp2_memory_);
+  tracker->TrackField("header_string_cache", header_string_cache_);
 }
 
 std::string Http2Session::diagnostic_name() const {
@@ -1043,6 +1063,7 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
   // so that it can send a WINDOW_UPDATE frame. This is a critical part of
   // the flow control process in http2
   CHECK_EQ(nghttp2_session_consume_connection(handle, len), 0);
+  session->UpdateWindowAutotuning(id, len);
   BaseObjectPtr<Http2Stream> stream = session->FindStream(id);
 
   // If the stream has been destroyed, ignore this chunk
@@ -1190,6 +1211,44 @@ void Http2StreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
 }
 
 
+MaybeLocal<String> Http2HeaderStringCache::Get(
+    Http2Session* session,
+    const Http2RcBufferPointer& buf) {
+  // Strings for static table entries are already shared through the
+  // per-isolate static_str_map.
+  if (buf.IsStatic() || buf.len() > kMaxHeaderStringCacheLength)
+    return Http2RcBufferPointer::External::New(session, buf);
+
+  Isolate* isolate = session->env()->isolate();
+  auto it = entries_.find(buf.get());
+  if (it != entries_.end()) {
+    hits_++;
+    return it->second.str.Get(isolate);
+  }
+
+  misses_++;
+  Local<String> str;
+  if (!Http2RcBufferPointer::External::New(session, buf).ToLocal(&str))
+    return MaybeLocal<String>();
+
+  if (entries_.size() == kMaxHeaderStringCacheEntries)
+    Clear();
+  entries_length_ += buf.len();
+  entries_.emplace(buf.get(), Entry { buf, Global<String>(isolate, str) });
+  return str;
+}
+
+void Http2HeaderStringCache::Clear() {
+  entries_.clear();
+  entries_length_ = 0;
+}
+
+void Http2HeaderStringCache::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("entries",
+                              entries_.size() * sizeof(Entry) +
+                                  entries_length_);
+}
+
 // Called by OnFrameReceived to notify JavaScript land that a complete
 // HEADERS frame has been received and processed. This method converts the
 // received headers into a JavaScript array and pushes those out to JS.
@@ -1217,8 +1276,19 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
 
   std::vector<Local<Value>> headers_v(stream->headers_count() * 2);
   stream->TransferHeaders([&](const Http2Header& header, size_t i) {
-    headers_v[i * 2] = header.GetName(this).ToLocalChecked();
-    headers_v[i * 2 + 1] = header.GetValue(this).ToLocalChecked();
+    // Fields the peer marked as never indexed usually carry credentials or
+    // other sensitive values, so they are not retained in the cache.
+    if (header.flags() & NGHTTP2_NV_FLAG_NO_INDEX) {
+      headers_v[i * 2] = Http2RcBufferPointer::External::New(
+          this, header.name_buffer()).ToLocalChecked();
+      headers_v[i * 2 + 1] = Http2RcBufferPointer::External::New(
+          this, header.value_buffer()).ToLocalChecked();
+      return;
+    }
+    headers_v[i * 2] =
+        header_string_cache_.Get(this, header.name_buffer()).ToLocalChecked();
+    headers_v[i * 2 + 1] =
+        header_string_cache_.Get(this, header.value_buffer()).ToLocalChecked();
   });
   CHECK_EQ(stream->headers_count(), 0);
 
@@ -1359,6 +1429,78 @@ void Http2Session::HandleOriginFrame(const nghttp2_frame* frame) {
   MakeCallback(env()->http2session_on_origin_function(), 1, &holder);
 }
 
+// Window autotuning follows the approach used by gRPC: While DATA is being
+// received, a PING is kept in flight, and the number of bytes received until
+// it is acknowledged is a sample of the bandwidth-delay product. If a sample
+// comes close to the current window size, the window was the limiting factor,
+// so it is grown to twice the sample, up to max_autotuned_window_size_.
+// The stream windows are raised lazily as DATA arrives for each stream.
+void Http2Session::UpdateWindowAutotuning(int32_t id, size_t length) {
+  if (max_autotuned_window_size_ == 0)
+    return;
+
+  if (!bdp_ping_outstanding_) {
+    // The BDP ping counts against maxOutstandingPings like any other PING.
+    if (outstanding_pings_.size() >= max_outstanding_pings_)
+      return;
+    if (nghttp2_submit_ping(session_.get(),
+                            NGHTTP2_FLAG_NONE,
+                            kBdpPingPayload) != 0) {
+      return;
+    }
+    bdp_ping_outstanding_ = true;
+    bdp_pings_ahead_ = outstanding_pings_.size();
+    bdp_ping_sent_at_ = uv_hrtime();
+    bdp_sample_ = 0;
+  }
+  bdp_sample_ += length;
+
+  int32_t window =
+      nghttp2_session_get_stream_effective_local_window_size(
+          session_.get(), id);
+  if (window >= 0 && static_cast<uint32_t>(window) < autotuned_window_size_) {
+    nghttp2_session_set_local_window_size(
+        session_.get(), NGHTTP2_FLAG_NONE, id, autotuned_window_size_);
+  }
+}
+
+void Http2Session::HandleBdpPingAck() {
+  bdp_ping_outstanding_ = false;
+
+  uint64_t rtt = std::max(uv_hrtime() - bdp_ping_sent_at_, uint64_t{1});
+  rtt_ = rtt_ == 0 ? rtt : (7 * rtt_ + rtt) / 8;
+  bdp_estimate_ = bdp_sample_;
+
+  // Only grow the window if the bandwidth is still increasing, so that
+  // variations in the RTT alone do not lead to ever larger windows.
+  double bandwidth = static_cast<double>(bdp_sample_) / rtt;
+  if (bandwidth < max_bandwidth_)
+    return;
+  max_bandwidth_ = bandwidth;
+
+  uint32_t window = std::max(
+      autotuned_window_size_,
+      nghttp2_session_get_local_settings(
+          session_.get(), NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE));
+  if (window >= max_autotuned_window_size_ || bdp_sample_ * 3 < window * 2)
+    return;
+
+  uint32_t target = static_cast<uint32_t>(
+      std::min(bdp_sample_ * 2,
+               static_cast<uint64_t>(max_autotuned_window_size_)));
+  if (target <= window)
+    return;
+  Debug(this, "autotuning flow control window to %d", target);
+  autotuned_window_size_ = target;
+
+  if (static_cast<uint32_t>(
+          nghttp2_session_get_effective_local_window_size(session_.get())) <
+      target) {
+    nghttp2_session_set_local_window_size(
+        session_.get(), NGHTTP2_FLAG_NONE, 0, target);
+  }
+}
+
 // Called by OnFrameReceived when a complete PING frame has been received.
 void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   Isolate* isolate = env()->isolate();
@@ -1368,6 +1510,19 @@ void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   Local<Value> arg;
   bool ack = frame->hd.flags & NGHTTP2_FLAG_ACK;
   if (ack) {
+    // PING ACKs are sent in the order the PINGs were received, so the ACK of
+    // the BDP ping follows those of the user PINGs submitted before it.
+    if (bdp_ping_outstanding_) {
+      if (bdp_pings_ahead_ == 0) {
+        if (memcmp(frame->ping.opaque_data, kBdpPingPayload, 8) == 0) {
+          HandleBdpPingAck();
+          return;
+        }
+      } else {
+        bdp_pings_ahead_--;
+      }
+    }
+
     BaseObjectPtr<Http2Ping> ping = PopPing();
 
     if (!ping) {
@@ -1558,6 +1713,17 @@ void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
   outgoing_storage_.resize(offset + src_length);
   memcpy(&outgoing_storage_[offset], src, src_length);
 
+  // If the previous chunk was copied as well, both are adjacent in
+  // outgoing_storage_ and can be passed to the socket as a single buffer.
+  // Copied chunks never carry a WriteWrap, so nothing is lost by merging.
+  if (!outgoing_buffers_.empty() &&
+      outgoing_buffers_.back().buf.base == nullptr) {
+    CHECK_NULL(outgoing_buffers_.back().req_wrap);
+    outgoing_buffers_.back().buf.len += src_length;
+    outgoing_length_ += src_length;
+    return;
+  }
+
   // Store with a base of `nullptr` initially, since future resizes
   // of the outgoing_buffers_ vector may invalidate the pointer.
   // The correct base pointers will be set later, before writing to the
@@ -1653,6 +1819,35 @@ uint8_t Http2Session::SendPendingData() {
 }
 
 
+// Called by nghttp2 to determine the maximum payload length of the next DATA
+// frame. By default, nghttp2 caps DATA frames at 16 KiB regardless of what the
+// peer allows. Since the payload is never copied (see OnSendData), larger
+// frames are cheap for us and mean fewer frame headers, fewer callbacks and
+// fewer buffers passed to the socket per write, so use as much of the peer's
+// SETTINGS_MAX_FRAME_SIZE as the flow control windows permit.
+// nghttp2 allocates its frame buffer according to the returned value even
+// though it does not fill it, so this is capped at kMaxDataFrameLength.
+ssize_t Http2Session::OnDataSourceReadLength(
+    nghttp2_session* session,
+    uint8_t frame_type,
+    int32_t stream_id,
+    int32_t session_remote_window_size,
+    int32_t stream_remote_window_size,
+    uint32_t remote_max_frame_size,
+    void* user_data) {
+  size_t max_length = std::min(
+      static_cast<size_t>(remote_max_frame_size), kMaxDataFrameLength);
+  // nghttp2 applies the flow control limits itself, but treats a value of
+  // zero as a fatal error, so only clamp to the windows if they are open.
+  if (session_remote_window_size > 0)
+    max_length = std::min(max_length,
+                          static_cast<size_t>(session_remote_window_size));
+  if (stream_remote_window_size > 0)
+    max_length = std::min(max_length,
+                          static_cast<size_t>(stream_remote_window_size));
+  return static_cast<ssize_t>(max_length);
+}
+
 // This callback is called from nghttp2 when it wants to send DATA frames for a
 // given Http2Stream, when we set the `NGHTTP2_DATA_FLAG_NO_COPY` flag earlier
 // in the Http2Stream::Provider::Stream::OnRead callback.
@@ -2425,6 +2620,17 @@ void Http2Session::RefreshState(const FunctionCallbackInfo<Value>& args) {
       static_cast<double>(nghttp2_session_get_hd_deflate_dynamic_table_size(s));
   buffer[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE] =
       static_cast<double>(nghttp2_session_get_hd_inflate_dynamic_table_size(s));
+  buffer[IDX_SESSION_STATE_HEADER_STRING_CACHE_HITS] =
+      static_cast<double>(session->header_string_cache_.hits());
+  buffer[IDX_SESSION_STATE_HEADER_STRING_CACHE_MISSES] =
+      static_cast<double>(session->header_string_cache_.misses());
+  buffer[IDX_SESSION_STATE_AUTOTUNED_WINDOW_SIZE] =
+      session->max_autotuned_window_size_ == 0 ?
+          0 : session->autotuned_window_size_;
+  buffer[IDX_SESSION_STATE_BDP_ESTIMATE] =
+      static_cast<double>(session->bdp_estimate_);
+  buffer[IDX_SESSION_STATE_RTT] =
+      static_cast<double>(session->rtt_) / 1e6;
 }
 
 
@@ -2805,7 +3011,9 @@ bool Http2Session::AddPing(const uint8_t* payload, Local<Function> callback) {
   if (!ping)
     return false;
 
-  if (outstanding_pings_.size() == max_outstanding_pings_) {
+  size_t outstanding =
+      outstanding_pings_.size() + (bdp_ping_outstanding_ ? 1 : 0);
+  if (outstanding >= max_outstanding_pings_) {
     ping->Done(false);
     return false;
   }
@@ -38,6 +38,16 @@ constexpr size_t kDefaultMaxSettings = 10;
 // Default maximum total memory cap for Http2Session.
 constexpr uint64_t kDefaultMaxSessionMemory = 10000000;
 
+// Limits for the per-session cache of received header strings. Only short
+// strings are cached, since those are the ones that repeat (names, content
+// types, paths, grpc-* metadata), and the cache is reset once it is full.
+constexpr size_t kMaxHeaderStringCacheEntries = 256;
+constexpr size_t kMaxHeaderStringCacheLength = 256;
+
+// Upper bound for the payload length of outgoing DATA frames, in addition to
+// the peer's SETTINGS_MAX_FRAME_SIZE.
+constexpr size_t kMaxDataFrameLength = 256 * 1024;
+
 // These are the standard HTTP/2 defaults as specified by the RFC
 constexpr uint32_t DEFAULT_SETTINGS_HEADER_TABLE_SIZE = 4096;
 constexpr uint32_t DEFAULT_SETTINGS_ENABLE_PUSH = 1;
@@ -234,9 +244,18 @@ class Http2Options {
     return max_session_memory_;
   }
 
+  void set_max_autotuned_window_size(uint32_t max) {
+    max_autotuned_window_size_ = max;
+  }
+
+  uint32_t max_autotuned_window_size() const {
+    return max_autotuned_window_size_;
+  }
+
  private:
   Nghttp2OptionPointer options_;
   uint64_t max_session_memory_ = kDefaultMaxSessionMemory;
+  uint32_t max_autotuned_window_size_ = 0;
   uint32_t max_header_pairs_ = DEFAULT_MAX_HEADER_LIST_PAIRS;
   PaddingStrategy padding_strategy_ = PADDING_STRATEGY_NONE;
   size_t max_outstanding_pings_ = kDefaultMaxPings;
@@ -267,6 +286,38 @@ struct Http2HeaderTraits {
 
 using Http2Header = NgHeader<Http2HeaderTraits>;
 
+// Caches the JS strings created for received header names and values.
+// Because of HPACK, the same names and values are received over and over
+// again on a session. nghttp2 hands out the same nghttp2_rcbuf for a given
+// dynamic table entry for as long as that entry exists, so the identity of
+// the rcbuf can be used as the cache key. Each entry holds a reference to its
+// rcbuf, so that the address cannot be reused for a different header while
+// the entry is alive.
+class Http2HeaderStringCache : public MemoryRetainer {
+ public:
+  v8::MaybeLocal<v8::String> Get(Http2Session* session,
+                                 const Http2RcBufferPointer& buf);
+  void Clear();
+
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(Http2HeaderStringCache)
+  SET_SELF_SIZE(Http2HeaderStringCache)
+
+ private:
+  struct Entry {
+    Http2RcBufferPointer buf;
+    v8::Global<v8::String> str;
+  };
+
+  std::unordered_map<nghttp2_rcbuf*, Entry> entries_;
+  size_t entries_length_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
 class Http2Stream : public AsyncWrap,
                     public StreamBase {
  public:
@@ -836,6 +887,14 @@ class Http2Session : public AsyncWrap,
       const char* message,
       size_t len,
       void* user_data);
+  static ssize_t OnDataSourceReadLength(
+      nghttp2_session* session,
+      uint8_t frame_type,
+      int32_t stream_id,
+      int32_t session_remote_window_size,
+      int32_t stream_remote_window_size,
+      uint32_t remote_max_frame_size,
+      void* user_data);
   static int OnSendData(
       nghttp2_session* session,
       nghttp2_frame* frame,
@@ -912,6 +971,29 @@ class Http2Session : public AsyncWrap,
   // Also use the invalid frame count as a measure for rejecting input frames.
   uint32_t invalid_frame_count_ = 0;
 
+  Http2HeaderStringCache header_string_cache_;
+
+  // State for autotuning the local flow control windows based on an estimate
+  // of the bandwidth-delay product. Autotuning is disabled if
+  // max_autotuned_window_size_ is 0.
+  uint32_t max_autotuned_window_size_ = 0;
+  uint32_t autotuned_window_size_ = DEFAULT_SETTINGS_INITIAL_WINDOW_SIZE;
+  bool bdp_ping_outstanding_ = false;
+  // Number of user PINGs whose ACKs are expected before that of the
+  // outstanding BDP ping.
+  size_t bdp_pings_ahead_ = 0;
+  uint64_t bdp_ping_sent_at_ = 0;
+  // Number of DATA bytes received since the outstanding BDP ping was sent.
+  uint64_t bdp_sample_ = 0;
+  uint64_t bdp_estimate_ = 0;
+  // Highest observed bandwidth, in bytes per nanosecond.
+  double max_bandwidth_ = 0;
+  // Smoothed round trip time measured through BDP pings, in nanoseconds.
+  uint64_t rtt_ = 0;
+
+  void UpdateWindowAutotuning(int32_t id, size_t length);
+  void HandleBdpPingAck();
+
   void PushOutgoingBuffer(NgHttp2StreamWrite&& write);
 
   BaseObjectPtr<Http2State> http2_state_;
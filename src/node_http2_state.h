@@ -31,6 +31,11 @@ namespace http2 {
     IDX_SESSION_STATE_OUTBOUND_QUEUE_SIZE,
     IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE,
     IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE,
+    IDX_SESSION_STATE_HEADER_STRING_CACHE_HITS,
+    IDX_SESSION_STATE_HEADER_STRING_CACHE_MISSES,
+    IDX_SESSION_STATE_AUTOTUNED_WINDOW_SIZE,
+    IDX_SESSION_STATE_BDP_ESTIMATE,
+    IDX_SESSION_STATE_RTT,
     IDX_SESSION_STATE_COUNT
   };
 
@@ -55,6 +60,7 @@ namespace http2 {
     IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS,
     IDX_OPTIONS_MAX_SESSION_MEMORY,
     IDX_OPTIONS_MAX_SETTINGS,
+    IDX_OPTIONS_MAX_AUTOTUNED_WINDOW_SIZE,
     IDX_OPTIONS_FLAGS
   };
 
@@ -506,6 +506,10 @@ class NgHeader final : public NgHeaderBase<typename T::allocator_t> {
   inline std::string value() const override;
   inline size_t length() const override;
 
+  const rcbufferpointer_t& name_buffer() const { return name_; }
+  const rcbufferpointer_t& value_buffer() const { return value_; }
+  uint8_t flags() const { return flags_; }
+
   void MemoryInfo(MemoryTracker* tracker) const override;
 
   SET_MEMORY_INFO_NAME(NgHeader)
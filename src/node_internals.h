@@ -147,6 +147,18 @@ class DebuggingArrayBufferAllocator final : public NodeArrayBufferAllocator {
   std::unordered_map<void*, size_t> allocations_;
 };
 
+// Serves small backing stores from a process-wide set of size classes that
+// is shared between all isolates, rather than from malloc(). Enabled through
+// --experimental-arraybuffer-arena. Memory is still accounted per allocator,
+// i.e. per isolate.
+class ArenaArrayBufferAllocator final : public NodeArrayBufferAllocator {
+ public:
+  void* Allocate(size_t size) override;
+  void* AllocateUninitialized(size_t size) override;
+  void Free(void* data, size_t size) override;
+  void* Reallocate(void* data, size_t old_size, size_t size) override;
+};
+
 namespace Buffer {
 v8::MaybeLocal<v8::Object> Copy(Environment* env, const char* data, size_t len);
 v8::MaybeLocal<v8::Object> New(Environment* env, size_t size);
@@ -17,6 +17,7 @@ using v8::BackingStore;
 using v8::CompiledWasmModule;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::False;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -27,11 +28,17 @@ using v8::Just;
 using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::Name;
+using v8::NewStringType;
 using v8::Nothing;
+using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Symbol;
+using v8::True;
+using v8::Undefined;
 using v8::Value;
 using v8::ValueDeserializer;
 using v8::ValueSerializer;
@@ -78,6 +85,287 @@ bool Message::IsCloseMessage() const {
 
 namespace {
 
+// The last byte of a simple message's buffer is one of these tags. The value
+// itself, if any, precedes it, so that it is suitably aligned.
+enum class SimpleMessageTag : uint8_t {
+  kUndefined,
+  kNull,
+  kTrue,
+  kFalse,
+  kNumber,
+  kOneByteString,
+  kTwoByteString,
+  kObject
+};
+
+// Objects with more properties than this take the regular path, so that the
+// property checks below cannot add up to a noticeable amount of work.
+constexpr uint32_t kMaxSimpleObjectProperties = 64;
+
+// Returns the tag used for a primitive value or string, and the number of
+// bytes its data takes up.
+bool GetSimpleTag(Local<Value> value, SimpleMessageTag* tag, size_t* size) {
+  *size = 0;
+  if (value->IsUndefined()) {
+    *tag = SimpleMessageTag::kUndefined;
+  } else if (value->IsNull()) {
+    *tag = SimpleMessageTag::kNull;
+  } else if (value->IsTrue()) {
+    *tag = SimpleMessageTag::kTrue;
+  } else if (value->IsFalse()) {
+    *tag = SimpleMessageTag::kFalse;
+  } else if (value->IsNumber()) {
+    *tag = SimpleMessageTag::kNumber;
+    *size = sizeof(double);
+  } else if (value->IsString()) {
+    Local<String> string = value.As<String>();
+    if (string->IsOneByte()) {
+      *tag = SimpleMessageTag::kOneByteString;
+      *size = string->Length();
+    } else {
+      *tag = SimpleMessageTag::kTwoByteString;
+      *size = string->Length() * sizeof(uint16_t);
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void WriteSimpleData(Isolate* isolate,
+                     Local<Value> value,
+                     SimpleMessageTag tag,
+                     size_t size,
+                     char* dest) {
+  switch (tag) {
+    case SimpleMessageTag::kNumber: {
+      double number = value.As<Number>()->Value();
+      memcpy(dest, &number, sizeof(number));
+      break;
+    }
+    case SimpleMessageTag::kOneByteString:
+      value.As<String>()->WriteOneByte(isolate,
+                                       reinterpret_cast<uint8_t*>(dest),
+                                       0,
+                                       size,
+                                       String::NO_NULL_TERMINATION);
+      break;
+    case SimpleMessageTag::kTwoByteString:
+      value.As<String>()->Write(isolate,
+                                reinterpret_cast<uint16_t*>(dest),
+                                0,
+                                size / sizeof(uint16_t),
+                                String::NO_NULL_TERMINATION);
+      break;
+    default:
+      break;
+  }
+}
+
+MaybeLocal<Value> ReadSimpleData(Isolate* isolate,
+                                 SimpleMessageTag tag,
+                                 const char* data,
+                                 size_t size) {
+  MaybeLocal<String> string;
+  switch (tag) {
+    case SimpleMessageTag::kUndefined:
+      return Undefined(isolate);
+    case SimpleMessageTag::kNull:
+      return Null(isolate);
+    case SimpleMessageTag::kTrue:
+      return True(isolate);
+    case SimpleMessageTag::kFalse:
+      return False(isolate);
+    case SimpleMessageTag::kNumber: {
+      double value;
+      memcpy(&value, data, sizeof(value));
+      return Number::New(isolate, value);
+    }
+    case SimpleMessageTag::kOneByteString:
+      string = String::NewFromOneByte(isolate,
+                                      reinterpret_cast<const uint8_t*>(data),
+                                      NewStringType::kNormal,
+                                      size);
+      break;
+    case SimpleMessageTag::kTwoByteString:
+      string = String::NewFromTwoByte(isolate,
+                                      reinterpret_cast<const uint16_t*>(data),
+                                      NewStringType::kNormal,
+                                      size / sizeof(uint16_t));
+      break;
+    default:
+      UNREACHABLE();
+  }
+  return string.FromMaybe(Local<String>());
+}
+
+// The members of a simple object are stored one after another as a key
+// followed by a value. Each of them starts with its tag and, for strings,
+// the byte length of the data as a uint32_t. Two-byte string data is padded
+// to an even offset.
+bool AppendSimpleMember(Isolate* isolate,
+                        Local<Value> value,
+                        std::vector<char>* out) {
+  SimpleMessageTag tag;
+  size_t size;
+  if (!GetSimpleTag(value, &tag, &size))
+    return false;
+  out->push_back(static_cast<char>(tag));
+  if (tag == SimpleMessageTag::kOneByteString ||
+      tag == SimpleMessageTag::kTwoByteString) {
+    uint32_t length = static_cast<uint32_t>(size);
+    const char* length_bytes = reinterpret_cast<const char*>(&length);
+    out->insert(out->end(), length_bytes, length_bytes + sizeof(length));
+    if (tag == SimpleMessageTag::kTwoByteString && out->size() % 2 != 0)
+      out->push_back(0);
+  }
+  size_t offset = out->size();
+  out->resize(offset + size);
+  WriteSimpleData(isolate, value, tag, size, out->data() + offset);
+  return true;
+}
+
+MaybeLocal<Value> ReadSimpleMember(Isolate* isolate,
+                                   const char* base,
+                                   size_t* offset) {
+  size_t pos = *offset;
+  SimpleMessageTag tag = static_cast<SimpleMessageTag>(base[pos++]);
+  size_t size = 0;
+  if (tag == SimpleMessageTag::kNumber) {
+    size = sizeof(double);
+  } else if (tag == SimpleMessageTag::kOneByteString ||
+             tag == SimpleMessageTag::kTwoByteString) {
+    uint32_t length;
+    memcpy(&length, base + pos, sizeof(length));
+    pos += sizeof(length);
+    if (tag == SimpleMessageTag::kTwoByteString && pos % 2 != 0)
+      pos++;
+    size = length;
+  }
+  *offset = pos + size;
+  return ReadSimpleData(isolate, tag, base + pos, size);
+}
+
+// Returns true if `object` is a plain object that the ValueSerializer would
+// write as an ordinary JS object. The instance type that the ValueSerializer
+// looks at is not exposed through the API, so rather than ruling out every
+// exotic object, only objects that were created by the Object constructor and
+// whose prototype is Object.prototype or null are accepted. Proxies, API
+// objects and arguments objects also report "Object" as their constructor
+// name, and are excluded explicitly.
+bool IsSimpleObject(Local<Context> context, Local<Object> object) {
+  Isolate* isolate = context->GetIsolate();
+  if (!object->IsObject() ||
+      object->IsExternal() ||
+      object->IsProxy() ||
+      object->IsApiWrapper() ||
+      object->IsArgumentsObject() ||
+      object->HasNamedLookupInterceptor() ||
+      object->HasIndexedLookupInterceptor() ||
+      !object->GetConstructorName()->StringEquals(
+          FIXED_ONE_BYTE_STRING(isolate, "Object"))) {
+    return false;
+  }
+  Local<Value> proto = object->GetPrototype();
+  if (proto->IsNull())
+    return true;
+  Context::Scope context_scope(context);
+  return proto->StrictEquals(Object::New(isolate)->GetPrototype());
+}
+
+}  // anonymous namespace
+
+bool Message::SerializeSimple(Local<Context> context, Local<Value> input) {
+  Isolate* isolate = context->GetIsolate();
+  SimpleMessageTag tag;
+  size_t size;
+  if (!GetSimpleTag(input, &tag, &size)) {
+    return input->IsObject() &&
+           SerializeSimpleObject(context, input.As<Object>());
+  }
+
+  MallocedBuffer<char> buf(size + 1);
+  buf.data[size] = static_cast<char>(tag);
+  WriteSimpleData(isolate, input, tag, size, buf.data);
+
+  main_message_buf_ = std::move(buf);
+  is_simple_ = true;
+  return true;
+}
+
+bool Message::SerializeSimpleObject(Local<Context> context,
+                                    Local<Object> input) {
+  Isolate* isolate = context->GetIsolate();
+  if (!IsSimpleObject(context, input))
+    return false;
+
+  // These are the keys that the ValueSerializer writes, in the same order.
+  Local<Array> keys;
+  if (!input->GetOwnPropertyNames(context,
+                                  static_cast<v8::PropertyFilter>(
+                                      v8::ONLY_ENUMERABLE |
+                                      v8::SKIP_SYMBOLS),
+                                  v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys) ||
+      keys->Length() > kMaxSimpleObjectProperties) {
+    return false;
+  }
+
+  std::vector<char> out;
+  for (uint32_t i = 0; i < keys->Length(); i++) {
+    Local<Value> key;
+    if (!keys->Get(context, i).ToLocal(&key))
+      return false;
+    // Accessors are ruled out before any of them runs, so that falling back
+    // to the ValueSerializer does not invoke a getter a second time.
+    Maybe<bool> is_accessor =
+        input->HasRealNamedCallbackProperty(context, key.As<Name>());
+    if (is_accessor.IsNothing() || is_accessor.FromJust())
+      return false;
+    Local<Value> value;
+    if (!input->Get(context, key).ToLocal(&value) ||
+        !AppendSimpleMember(isolate, key, &out) ||
+        !AppendSimpleMember(isolate, value, &out)) {
+      return false;
+    }
+  }
+
+  MallocedBuffer<char> buf(out.size() + 1);
+  memcpy(buf.data, out.data(), out.size());
+  buf.data[out.size()] = static_cast<char>(SimpleMessageTag::kObject);
+
+  main_message_buf_ = std::move(buf);
+  is_simple_ = true;
+  return true;
+}
+
+MaybeLocal<Value> Message::DeserializeSimple(Local<Context> context) {
+  Isolate* isolate = context->GetIsolate();
+  const char* data = main_message_buf_.data;
+  size_t size = main_message_buf_.size - 1;
+  SimpleMessageTag tag = static_cast<SimpleMessageTag>(data[size]);
+  if (tag != SimpleMessageTag::kObject)
+    return ReadSimpleData(isolate, tag, data, size);
+
+  EscapableHandleScope handle_scope(isolate);
+  Context::Scope context_scope(context);
+  Local<Object> object = Object::New(isolate);
+  size_t offset = 0;
+  while (offset < size) {
+    Local<Value> key;
+    Local<Value> value;
+    if (!ReadSimpleMember(isolate, data, &offset).ToLocal(&key) ||
+        !ReadSimpleMember(isolate, data, &offset).ToLocal(&value) ||
+        object->CreateDataProperty(context, key.As<Name>(), value)
+            .IsNothing()) {
+      return MaybeLocal<Value>();
+    }
+  }
+  return handle_scope.Escape(object);
+}
+
+namespace {
+
 // This is used to tell V8 how to read transferred host objects, like other
 // `MessagePort`s and `SharedArrayBuffer`s, and make new JS objects out of them.
 class DeserializerDelegate : public ValueDeserializer::Delegate {
@@ -127,6 +415,8 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
 MaybeLocal<Value> Message::Deserialize(Environment* env,
                                        Local<Context> context) {
   CHECK(!IsCloseMessage());
+  if (is_simple_)
+    return DeserializeSimple(context);
 
   EscapableHandleScope handle_scope(env->isolate());
   Context::Scope context_scope(context);
@@ -392,6 +682,11 @@ Maybe<bool> Message::Serialize(Environment* env,
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
 
+  if (transfer_list_v.length() == 0 &&
+      SerializeSimple(context, input)) {
+    return Just(true);
+  }
+
   SerializerDelegate delegate(env, context, this);
   ValueSerializer serializer(env->isolate(), &delegate);
   delegate.serializer = &serializer;
@@ -522,19 +817,32 @@ MessagePortData::~MessagePortData() {
 void MessagePortData::MemoryInfo(MemoryTracker* tracker) const {
   Mutex::ScopedLock lock(mutex_);
   tracker->TrackField("incoming_messages", incoming_messages_);
+  tracker->TrackField("pending_messages", pending_messages_);
 }
 
 void MessagePortData::AddToIncomingQueue(Message&& message) {
   // This function will be called by other threads.
   Mutex::ScopedLock lock(mutex_);
+  bool was_empty = incoming_messages_.empty();
   incoming_messages_.emplace_back(std::move(message));
 
-  if (owner_ != nullptr) {
+  // The owner only stops draining `incoming_messages_` once it is empty, or
+  // schedules itself again (or waits for Start()) when it leaves messages
+  // behind, so it only needs to be woken up when the queue stops being empty.
+  // This saves one uv_async_send() per message while the receiver is busy.
+  if (owner_ != nullptr && was_empty) {
     Debug(owner_, "Adding message to incoming queue");
     owner_->TriggerAsync();
   }
 }
 
+bool MessagePortData::MoveIncomingToPending() {
+  Mutex::ScopedLock lock(mutex_);
+  if (incoming_messages_.empty()) return false;
+  pending_messages_.splice(pending_messages_.end(), incoming_messages_);
+  return true;
+}
+
 void MessagePortData::Entangle(MessagePortData* a, MessagePortData* b) {
   CHECK_NULL(a->sibling_);
   CHECK_NULL(b->sibling_);
@@ -678,24 +986,23 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
                                               bool only_if_receiving) {
   Message received;
   {
-    // Get the head of the message queue.
-    Mutex::ScopedLock lock(data_->mutex_);
+    // Get the head of the message queue. Messages are taken out of the
+    // shared queue in batches, so that the lock is only acquired once per
+    // batch rather than once per message.
+    std::list<Message>& pending = data_->pending_messages_;
+    if (pending.empty() && !data_->MoveIncomingToPending())
+      return env()->no_message_symbol();
 
     Debug(this, "MessagePort has message");
 
     bool wants_message = receiving_messages_ || !only_if_receiving;
-    // We have nothing to do if:
-    // - There are no pending messages
-    // - We are not intending to receive messages, and the message we would
-    //   receive is not the final "close" message.
-    if (data_->incoming_messages_.empty() ||
-        (!wants_message &&
-         !data_->incoming_messages_.front().IsCloseMessage())) {
+    // We have nothing to do if we are not intending to receive messages, and
+    // the message we would receive is not the final "close" message.
+    if (!wants_message && !pending.front().IsCloseMessage())
       return env()->no_message_symbol();
-    }
 
-    received = std::move(data_->incoming_messages_.front());
-    data_->incoming_messages_.pop_front();
+    received = std::move(pending.front());
+    pending.pop_front();
   }
 
   if (received.IsCloseMessage()) {
@@ -715,8 +1022,9 @@ void MessagePort::OnMessage() {
 
   size_t processing_limit;
   {
-    Mutex::ScopedLock(data_->mutex_);
-    processing_limit = std::max(data_->incoming_messages_.size(),
+    Mutex::ScopedLock lock(data_->mutex_);
+    processing_limit = std::max(data_->incoming_messages_.size() +
+                                    data_->pending_messages_.size(),
                                 static_cast<size_t>(1000));
   }
 
@@ -970,7 +1278,7 @@ void MessagePort::Start() {
   Debug(this, "Start receiving messages");
   receiving_messages_ = true;
   Mutex::ScopedLock lock(data_->mutex_);
-  if (!data_->incoming_messages_.empty())
+  if (!data_->incoming_messages_.empty() || !data_->pending_messages_.empty())
     TriggerAsync();
 }
 
@@ -96,7 +96,18 @@ class Message : public MemoryRetainer {
   SET_SELF_SIZE(Message)
 
  private:
+  // Messages that consist of a single primitive value or string, or of a
+  // plain object whose own properties all have such values, and that do not
+  // transfer any objects skip the ValueSerializer, and store the value
+  // directly in `main_message_buf_` instead.
+  bool SerializeSimple(v8::Local<v8::Context> context,
+                       v8::Local<v8::Value> input);
+  bool SerializeSimpleObject(v8::Local<v8::Context> context,
+                             v8::Local<v8::Object> input);
+  v8::MaybeLocal<v8::Value> DeserializeSimple(v8::Local<v8::Context> context);
+
   MallocedBuffer<char> main_message_buf_;
+  bool is_simple_ = false;
   std::vector<std::shared_ptr<v8::BackingStore>> array_buffers_;
   std::vector<std::shared_ptr<v8::BackingStore>> shared_array_buffers_;
   std::vector<std::unique_ptr<TransferData>> transferables_;
@@ -141,11 +152,20 @@ class MessagePortData : public TransferData {
   SET_SELF_SIZE(MessagePortData)
 
  private:
+  // Moves all messages from `incoming_messages_` to `pending_messages_`,
+  // so that the owner thread can process them without holding `mutex_`.
+  // Returns false if there were no messages to receive.
+  bool MoveIncomingToPending();
+
   // This mutex protects all fields below it, with the exception of
-  // sibling_.
+  // pending_messages_ and sibling_.
   mutable Mutex mutex_;
   std::list<Message> incoming_messages_;
   MessagePort* owner_ = nullptr;
+  // Messages that have already been taken out of `incoming_messages_` as
+  // one batch. This is only accessed by the thread that owns the port, and
+  // always precedes `incoming_messages_` in delivery order.
+  std::list<Message> pending_messages_;
   // This mutex protects the sibling_ field and is shared between two entangled
   // MessagePorts. If both mutexes are acquired, this one needs to be
   // acquired first.
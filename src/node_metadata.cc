@@ -8,6 +8,7 @@
 #include "uv.h"
 #include "v8.h"
 #include "zlib.h"
+#include "zstd.h"
 
 #if HAVE_OPENSSL
 #include <openssl/opensslv.h>
@@ -91,6 +92,8 @@ Metadata::Versions::Versions() {
   openssl = GetOpenSSLVersion();
 #endif
 
+  zstd = ZSTD_versionString();
+
 #ifdef NODE_HAVE_I18N_SUPPORT
   icu = U_ICU_VERSION;
   unicode = U_UNICODE_VERSION;
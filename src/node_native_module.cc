@@ -260,15 +260,20 @@ MaybeLocal<Function> NativeModuleLoader::LookupAndCompile(
   Local<Integer> column_offset = Integer::New(isolate, 0);
   ScriptOrigin origin(filename, line_offset, column_offset, True(isolate));
 
-  Mutex::ScopedLock lock(code_cache_mutex_);
-
+  // Compile from a copy of the cache entry, so that the lock does not have to
+  // be held during compilation and other threads (e.g. Workers that are
+  // starting up at the same time) can keep using the entry meanwhile.
   ScriptCompiler::CachedData* cached_data = nullptr;
   {
+    Mutex::ScopedLock lock(code_cache_mutex_);
     auto cache_it = code_cache_.find(id);
     if (cache_it != code_cache_.end()) {
-      // Transfer ownership to ScriptCompiler::Source later.
-      cached_data = cache_it->second.release();
-      code_cache_.erase(cache_it);
+      const ScriptCompiler::CachedData* entry = cache_it->second.get();
+      uint8_t* data = new uint8_t[entry->length];
+      memcpy(data, entry->data, entry->length);
+      // Ownership is transferred to ScriptCompiler::Source later.
+      cached_data = new ScriptCompiler::CachedData(
+          data, entry->length, ScriptCompiler::CachedData::BufferOwned);
     }
   }
 
@@ -305,13 +310,17 @@ MaybeLocal<Function> NativeModuleLoader::LookupAndCompile(
   *result = (has_cache && !script_source.GetCachedData()->rejected)
                 ? Result::kWithCache
                 : Result::kWithoutCache;
-  // Generate new cache for next compilation
-  std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
-      ScriptCompiler::CreateCodeCacheForFunction(fun));
-  CHECK_NOT_NULL(new_cached_data);
 
-  // The old entry should've been erased by now so we can just emplace
-  code_cache_.emplace(id, std::move(new_cached_data));
+  // An accepted cache already covers everything that was compiled eagerly,
+  // so only generate a new one if there was none or it was rejected.
+  if (*result == Result::kWithoutCache) {
+    std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
+        ScriptCompiler::CreateCodeCacheForFunction(fun));
+    CHECK_NOT_NULL(new_cached_data);
+
+    Mutex::ScopedLock lock(code_cache_mutex_);
+    code_cache_[id] = std::move(new_cached_data);
+  }
 
   return scope.Escape(fun);
 }
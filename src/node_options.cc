@@ -352,6 +352,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "",
             &EnvironmentOptions::es_module_specifier_resolution,
             kAllowedInEnvironment);
+  AddOption("--no-crypto-entropy-cache",
+            "do not serve crypto.randomBytes() and crypto.randomUUID() "
+            "from a cache of random data",
+            &EnvironmentOptions::no_crypto_entropy_cache,
+            kAllowedInEnvironment);
   AddOption("--no-deprecation",
             "silence deprecation warnings",
             &EnvironmentOptions::no_deprecation,
@@ -639,6 +644,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "", /* undocumented, only for debugging */
             &PerProcessOptions::debug_arraybuffer_allocations,
             kAllowedInEnvironment);
+  AddOption("--experimental-arraybuffer-arena",
+            "allocate small ArrayBuffers from a pool that is shared "
+            "between all threads",
+            &PerProcessOptions::experimental_arraybuffer_arena,
+            kAllowedInEnvironment);
   AddOption("--disable-proto",
             "disable Object.prototype.__proto__",
             &PerProcessOptions::disable_proto,
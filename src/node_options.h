@@ -117,6 +117,7 @@ class EnvironmentOptions : public Options {
   bool frozen_intrinsics = false;
   std::string heap_snapshot_signal;
   uint64_t max_http_header_size = 16 * 1024;
+  bool no_crypto_entropy_cache = false;
   bool no_deprecation = false;
   bool no_force_async_hooks_checks = false;
   bool no_warnings = false;
@@ -211,6 +212,7 @@ class PerProcessOptions : public Options {
   int64_t v8_thread_pool_size = 4;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
+  bool experimental_arraybuffer_arena = false;
   std::string disable_proto;
 
   std::vector<std::string> security_reverts;
@@ -4,9 +4,12 @@
 #include "node_i18n.h"
 #include "util-inl.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace node {
@@ -17,8 +20,10 @@ using v8::Array;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Int32;
+using v8::Int32Array;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -140,12 +145,32 @@ URLHost::~URLHost() {
   XX(ERR_ARG_FLAGS)                                                           \
   XX(ERR_ARG_INPUT)                                                           \
 
+// Fields of the Int32Array that ParseHref() fills in. Apart from the flags
+// and the port, these are offsets into the serialized URL.
+#define COMPONENTS(XX)                                                        \
+  XX(kComponentFlags)                                                         \
+  XX(kComponentPort)                                                          \
+  XX(kProtocolEnd)                                                            \
+  XX(kUsernameEnd)                                                            \
+  XX(kHostStart)                                                              \
+  XX(kHostEnd)                                                                \
+  XX(kPathnameStart)                                                          \
+  XX(kSearchStart)                                                            \
+  XX(kHashStart)                                                              \
+  XX(kComponentCount)  // This one has to be last.
+
 enum url_cb_args {
 #define XX(name) name,
   ARGS(XX)
 #undef XX
 };
 
+enum url_components {
+#define XX(name) name,
+  COMPONENTS(XX)
+#undef XX
+};
+
 enum url_error_cb_args {
 #define XX(name) name,
   ERR_ARGS(XX)
@@ -2212,6 +2237,120 @@ void Parse(const FunctionCallbackInfo<Value>& args) {
         args[5]);
 }
 
+// Serializes `url` the same way as the href getter of the JS URL class does,
+// and records where each component starts and ends in the result.
+void SerializeURL(const struct url_data& url,
+                  std::string* href,
+                  int32_t* components) {
+  const int32_t flags = url.flags;
+  size_t size = url.scheme.size() + url.username.size() +
+                url.password.size() + url.host.size() + url.query.size() +
+                url.fragment.size() + 16;
+  for (const std::string& segment : url.path)
+    size += segment.size() + 1;
+  href->reserve(size);
+
+  *href += url.scheme;
+  components[kProtocolEnd] = href->size();
+  if (flags & URL_FLAGS_HAS_HOST) {
+    *href += "//";
+    const bool has_username =
+        (flags & URL_FLAGS_HAS_USERNAME) && !url.username.empty();
+    const bool has_password =
+        (flags & URL_FLAGS_HAS_PASSWORD) && !url.password.empty();
+    if (has_username)
+      *href += url.username;
+    components[kUsernameEnd] = href->size();
+    if (has_password) {
+      *href += ':';
+      *href += url.password;
+    }
+    if (has_username || has_password)
+      *href += '@';
+    components[kHostStart] = href->size();
+    *href += url.host;
+    components[kHostEnd] = href->size();
+    if (url.port > -1) {
+      *href += ':';
+      *href += std::to_string(url.port);
+    }
+  } else {
+    if (url.scheme == "file:")
+      *href += "//";
+    components[kUsernameEnd] = href->size();
+    components[kHostStart] = href->size();
+    components[kHostEnd] = href->size();
+  }
+
+  components[kPathnameStart] = href->size();
+  if (flags & URL_FLAGS_HAS_PATH) {
+    if (flags & URL_FLAGS_CANNOT_BE_BASE) {
+      if (!url.path.empty())
+        *href += url.path[0];
+    } else {
+      for (const std::string& segment : url.path) {
+        *href += '/';
+        *href += segment;
+      }
+    }
+  }
+
+  components[kSearchStart] = href->size();
+  if (flags & URL_FLAGS_HAS_QUERY) {
+    *href += '?';
+    *href += url.query;
+  }
+
+  components[kHashStart] = href->size();
+  if (flags & URL_FLAGS_HAS_FRAGMENT) {
+    *href += '#';
+    *href += url.fragment;
+  }
+
+  components[kComponentFlags] = flags;
+  components[kComponentPort] = url.port;
+}
+
+// Parses `input`, optionally against the URL record `base`, and returns the
+// serialized URL as a single string, instead of calling back into JS with a
+// separate string for each component. The flags, the port and the component
+// offsets are written to the Int32Array that is passed as the third argument,
+// so that the components can be sliced out of the string in JS.
+// Returns undefined if the input is not a valid URL, and null if the result is
+// not plain ASCII, because the offsets are byte offsets. The latter should not
+// happen for valid URLs, and callers fall back to parse() in that case.
+void ParseHref(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());  // input
+  CHECK(args[1]->IsUndefined() || args[1]->IsObject());  // base context
+  CHECK(args[2]->IsInt32Array());  // components
+  Local<Int32Array> array = args[2].As<Int32Array>();
+  CHECK_EQ(array->Length(), kComponentCount);
+  int32_t* components = reinterpret_cast<int32_t*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+
+  Utf8Value input(env->isolate(), args[0]);
+  const bool has_base = args[1]->IsObject();
+  url_data base;
+  if (has_base)
+    base = HarvestBase(env, args[1].As<Object>());
+  url_data url;
+  URL::Parse(*input, input.length(), kUnknownState, &url, false,
+             &base, has_base);
+  if (url.flags & URL_FLAGS_FAILED)
+    return;
+
+  std::string href;
+  SerializeURL(url, &href, components);
+  for (const char ch : href) {
+    if (static_cast<unsigned char>(ch) > 0x7f)
+      return args.GetReturnValue().SetNull();
+  }
+  args.GetReturnValue().Set(
+      OneByteString(env->isolate(), href.data(), href.size()));
+}
+
 void EncodeAuthSet(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK_GE(args.Length(), 1);
@@ -2304,6 +2443,181 @@ void DomainToUnicode(const FunctionCallbackInfo<Value>& args) {
                           NewStringType::kNormal).ToLocalChecked());
 }
 
+// A set of path patterns, compiled into a tree with one level per path
+// segment. Segments of a pattern are either matched literally, or are
+// `:name` segments that match any single non-empty segment. The last segment
+// may also be `*`, which matches the rest of the path. Literal segments take
+// precedence over `:name` segments, which take precedence over `*`,
+// independent of the order in which the patterns were added.
+class RouteTable : public BaseObject {
+ public:
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    Environment* env = Environment::GetCurrent(args);
+    new RouteTable(env, args.This());
+  }
+
+  // add(pattern, id): The pattern has already been validated in JS. Returns
+  // false if an equivalent pattern has been added before.
+  static void Add(const FunctionCallbackInfo<Value>& args) {
+    RouteTable* table;
+    ASSIGN_OR_RETURN_UNWRAP(&table, args.Holder());
+    CHECK(args[0]->IsString());
+    CHECK(args[1]->IsInt32());
+    Utf8Value pattern(args.GetIsolate(), args[0]);
+    int32_t id = args[1].As<Int32>()->Value();
+    CHECK_GE(id, 0);
+    CHECK_EQ(pattern[0], '/');
+
+    Node* node = &table->root_;
+    const char* p = *pattern;
+    const char* end = p + pattern.length();
+    while (p != end) {
+      const char* start = p + 1;
+      p = std::find(start, end, '/');
+      if (p == end && p - start == 1 && *start == '*') {
+        if (node->wildcard_id != -1)
+          return args.GetReturnValue().Set(false);
+        node->wildcard_id = id;
+        return args.GetReturnValue().Set(true);
+      }
+      if (start != p && *start == ':') {
+        if (!node->param)
+          node->param.reset(new Node());
+        node = node->param.get();
+      } else {
+        node = node->AddChild(start, p - start);
+      }
+    }
+    if (node->id != -1)
+      return args.GetReturnValue().Set(false);
+    node->id = id;
+    args.GetReturnValue().Set(true);
+  }
+
+  // match(path): Returns undefined if no pattern matches the path, or an array
+  // that contains the id of the matching pattern, followed by the values of
+  // its `:name` and `*` segments. Anything from the first `?` or `#` on is
+  // ignored.
+  static void Match(const FunctionCallbackInfo<Value>& args) {
+    RouteTable* table;
+    ASSIGN_OR_RETURN_UNWRAP(&table, args.Holder());
+    CHECK(args[0]->IsString());
+    Isolate* isolate = args.GetIsolate();
+    Utf8Value path(isolate, args[0]);
+    const char* begin = *path;
+    const char* end = std::find_if(begin, begin + path.length(), [](char c) {
+      return c == '?' || c == '#';
+    });
+    if (begin == end || *begin != '/')
+      return;
+
+    std::vector<Capture>* captures = &table->captures_;
+    captures->clear();
+    int32_t id;
+    if (!table->root_.Lookup(begin, end, captures, &id))
+      return;
+
+    MaybeStackBuffer<Local<Value>, 8> values(captures->size() + 1);
+    values[0] = Integer::New(isolate, id);
+    for (size_t i = 0; i < captures->size(); i++) {
+      const Capture& capture = (*captures)[i];
+      values[i + 1] = String::NewFromUtf8(isolate,
+                                          capture.first,
+                                          NewStringType::kNormal,
+                                          capture.second).ToLocalChecked();
+    }
+    args.GetReturnValue().Set(
+        Array::New(isolate, values.out(), values.length()));
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(RouteTable)
+  SET_SELF_SIZE(RouteTable)
+
+ private:
+  typedef std::pair<const char*, size_t> Capture;
+
+  struct Node {
+    // Sorted by segment, so that they can be looked up through binary search.
+    std::vector<std::pair<std::string, std::unique_ptr<Node>>> children;
+    std::unique_ptr<Node> param;
+    int32_t id = -1;
+    int32_t wildcard_id = -1;
+
+    static bool IsLess(const std::pair<std::string, std::unique_ptr<Node>>& a,
+                       const std::pair<const char*, size_t>& b) {
+      return a.first.compare(0, std::string::npos, b.first, b.second) < 0;
+    }
+
+    Node* FindChild(const char* segment, size_t length) const {
+      auto it = std::lower_bound(children.begin(), children.end(),
+                                 std::make_pair(segment, length), IsLess);
+      if (it == children.end() ||
+          it->first.compare(0, std::string::npos, segment, length) != 0) {
+        return nullptr;
+      }
+      return it->second.get();
+    }
+
+    Node* AddChild(const char* segment, size_t length) {
+      auto it = std::lower_bound(children.begin(), children.end(),
+                                 std::make_pair(segment, length), IsLess);
+      if (it == children.end() ||
+          it->first.compare(0, std::string::npos, segment, length) != 0) {
+        it = children.emplace(it, std::string(segment, length),
+                              std::unique_ptr<Node>(new Node()));
+      }
+      return it->second.get();
+    }
+
+    // `p` points to the `/` that starts the next segment, or to `end`. The
+    // recursion is bounded by the number of segments of the longest pattern,
+    // not by the length of the path.
+    bool Lookup(const char* p,
+                const char* end,
+                std::vector<Capture>* captures,
+                int32_t* matched_id) const {
+      if (p == end) {
+        if (id == -1)
+          return false;
+        *matched_id = id;
+        return true;
+      }
+
+      const char* start = p + 1;
+      const char* next = std::find(start, end, '/');
+      const size_t length = next - start;
+      const Node* child = FindChild(start, length);
+      if (child != nullptr && child->Lookup(next, end, captures, matched_id))
+        return true;
+
+      if (param && length > 0) {
+        captures->emplace_back(start, length);
+        if (param->Lookup(next, end, captures, matched_id))
+          return true;
+        captures->pop_back();
+      }
+
+      if (wildcard_id != -1) {
+        captures->emplace_back(start, end - start);
+        *matched_id = wildcard_id;
+        return true;
+      }
+      return false;
+    }
+  };
+
+  RouteTable(Environment* env, Local<Object> object)
+      : BaseObject(env, object) {
+    MakeWeak();
+  }
+
+  Node root_;
+  // Reused between match() calls.
+  std::vector<Capture> captures_;
+};
+
 void SetURLConstructor(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK_EQ(args.Length(), 1);
@@ -2317,18 +2631,38 @@ void Initialize(Local<Object> target,
                 void* priv) {
   Environment* env = Environment::GetCurrent(context);
   env->SetMethod(target, "parse", Parse);
+  env->SetMethod(target, "parseHref", ParseHref);
   env->SetMethodNoSideEffect(target, "encodeAuth", EncodeAuthSet);
   env->SetMethodNoSideEffect(target, "toUSVString", ToUSVString);
   env->SetMethodNoSideEffect(target, "domainToASCII", DomainToASCII);
   env->SetMethodNoSideEffect(target, "domainToUnicode", DomainToUnicode);
   env->SetMethod(target, "setURLConstructor", SetURLConstructor);
 
+  {
+    Local<FunctionTemplate> rt = env->NewFunctionTemplate(RouteTable::New);
+
+    rt->InstanceTemplate()->SetInternalFieldCount(
+        RouteTable::kInternalFieldCount);
+    rt->Inherit(BaseObject::GetConstructorTemplate(env));
+
+    env->SetProtoMethod(rt, "add", RouteTable::Add);
+    env->SetProtoMethodNoSideEffect(rt, "match", RouteTable::Match);
+
+    Local<String> rt_string =
+        FIXED_ONE_BYTE_STRING(env->isolate(), "RouteTable");
+    rt->SetClassName(rt_string);
+    target->Set(env->context(),
+                rt_string,
+                rt->GetFunction(env->context()).ToLocalChecked()).Check();
+  }
+
 #define XX(name, _) NODE_DEFINE_CONSTANT(target, name);
   FLAGS(XX)
 #undef XX
 
 #define XX(name) NODE_DEFINE_CONSTANT(target, name);
   PARSESTATES(XX)
+  COMPONENTS(XX)
 #undef XX
 }
 }  // namespace
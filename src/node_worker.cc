@@ -3,15 +3,24 @@
 #include "memory_tracker-inl.h"
 #include "node_errors.h"
 #include "node_buffer.h"
+#include "node_main_instance.h"
 #include "node_options-inl.h"
 #include "node_perf.h"
 #include "util-inl.h"
 #include "async_wrap-inl.h"
+#include "handle_wrap.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
 
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
 using node::kAllowedInEnvironment;
 using node::kDisallowedInEnvironment;
 using v8::Array;
@@ -22,6 +31,8 @@ using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Int32;
+using v8::Int32Array;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -34,6 +45,7 @@ using v8::ResourceConstraints;
 using v8::SealHandleScope;
 using v8::String;
 using v8::TryCatch;
+using v8::Uint32;
 using v8::Value;
 
 namespace node {
@@ -120,6 +132,10 @@ void Worker::UpdateResourceConstraints(ResourceConstraints* constraints) {
   }
 }
 
+// The embedded snapshot does not contain any external references yet, see
+// the matching TODO in node::Start().
+static const intptr_t kSnapshotExternalReferences[] = { 0 };
+
 // This class contains data that is only relevant to the child thread itself,
 // and only while it is running.
 // (Eventually, the Environment instance should probably also be moved here.)
@@ -136,6 +152,12 @@ class WorkerThreadData {
     }
     loop_init_failed_ = false;
 
+    CHECK_EQ(uv_async_init(&loop_, &loop_probe_, [](uv_async_t* handle) {
+      static_cast<Worker*>(handle->data)->loop_probe_sent_.store(0);
+    }), 0);
+    loop_probe_.data = w;
+    uv_unref(reinterpret_cast<uv_handle_t*>(&loop_probe_));
+
     std::shared_ptr<ArrayBufferAllocator> allocator =
         ArrayBufferAllocator::Create();
     Isolate::CreateParams params;
@@ -144,6 +166,23 @@ class WorkerThreadData {
 
     w->UpdateResourceConstraints(&params.constraints);
 
+    // Deserialize the Isolate and the Context from the same snapshot as the
+    // main thread, rather than running the per-Isolate and per-Context
+    // setup code again for every Worker.
+    const std::vector<size_t>* indexes = nullptr;
+    const PerIsolateOptions* per_isolate_opts =
+        w->per_isolate_opts_ ? w->per_isolate_opts_.get() :
+                               per_process::cli_options->per_isolate.get();
+    if (!per_isolate_opts->no_node_snapshot) {
+      v8::StartupData* blob = NodeMainInstance::GetEmbeddedSnapshotBlob();
+      if (blob != nullptr) {
+        params.external_references = kSnapshotExternalReferences;
+        params.snapshot_blob = blob;
+        indexes = NodeMainInstance::GetIsolateDataIndexes();
+        deserialize_mode_ = true;
+      }
+    }
+
     Isolate* isolate = Isolate::Allocate();
     if (isolate == nullptr) {
       // TODO(addaleax): This should be ERR_WORKER_INIT_FAILED,
@@ -154,7 +193,12 @@ class WorkerThreadData {
 
     w->platform_->RegisterIsolate(isolate, &loop_);
     Isolate::Initialize(isolate, params);
-    SetIsolateUpForNode(isolate);
+    SetIsolateMiscHandlers(isolate, {});
+    if (!deserialize_mode_) {
+      // If in deserialize mode, delay until after the deserialization is
+      // complete.
+      SetIsolateErrorHandlers(isolate, {});
+    }
 
     isolate->AddNearHeapLimitCallback(Worker::NearHeapLimit, w);
 
@@ -166,10 +210,11 @@ class WorkerThreadData {
       isolate->SetStackLimit(w->stack_base_);
 
       HandleScope handle_scope(isolate);
-      isolate_data_.reset(CreateIsolateData(isolate,
-                                            &loop_,
-                                            w_->platform_,
-                                            allocator.get()));
+      isolate_data_.reset(new IsolateData(isolate,
+                                          &loop_,
+                                          w_->platform_,
+                                          allocator.get(),
+                                          indexes));
       CHECK(isolate_data_);
       if (w_->per_isolate_opts_)
         isolate_data_->set_options(std::move(w_->per_isolate_opts_));
@@ -182,6 +227,9 @@ class WorkerThreadData {
 
   ~WorkerThreadData() {
     Debug(w_, "Worker %llu dispose isolate", w_->thread_id_.id);
+    if (!loop_init_failed_)
+      uv_close(reinterpret_cast<uv_handle_t*>(&loop_probe_), nullptr);
+
     Isolate* isolate;
     {
       Mutex::ScopedLock lock(w_->mutex_);
@@ -213,6 +261,7 @@ class WorkerThreadData {
       }
     }
     if (!loop_init_failed_) {
+      uv_run(&loop_, UV_RUN_NOWAIT);
       CheckedUvLoopClose(&loop_);
     }
   }
@@ -222,7 +271,9 @@ class WorkerThreadData {
  private:
   Worker* const w_;
   uv_loop_t loop_;
+  uv_async_t loop_probe_;
   bool loop_init_failed_ = true;
+  bool deserialize_mode_ = false;
   DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data_;
 
   friend class Worker;
@@ -291,7 +342,16 @@ void Worker::Run() {
         // resource constraints, we need something in place to handle it,
         // though.
         TryCatch try_catch(isolate_);
-        context = NewContext(isolate_);
+        if (data.deserialize_mode_) {
+          if (Context::FromSnapshot(isolate_,
+                                    NodeMainInstance::kNodeContextIndex)
+                  .ToLocal(&context)) {
+            InitializeContextRuntime(context);
+          }
+          SetIsolateErrorHandlers(isolate_, {});
+        } else {
+          context = NewContext(isolate_);
+        }
         if (context.IsEmpty()) {
           // TODO(addaleax): This should be ERR_WORKER_INIT_FAILED,
           // ERR_WORKER_OUT_OF_MEMORY is for reaching the per-Worker heap limit.
@@ -341,6 +401,10 @@ void Worker::Run() {
         bool more;
         env_->performance_state()->Mark(
             node::performance::NODE_PERFORMANCE_MILESTONE_LOOP_START);
+        {
+          Mutex::ScopedLock lock(mutex_);
+          loop_probe_ = &data.loop_probe_;
+        }
         do {
           if (is_stopped()) break;
           uv_run(&data.loop_, UV_RUN_DEFAULT);
@@ -357,6 +421,11 @@ void Worker::Run() {
           // event, or after running some callbacks.
           more = uv_loop_alive(&data.loop_);
         } while (more == true && !is_stopped());
+        {
+          Mutex::ScopedLock lock(mutex_);
+          loop_probe_ = nullptr;
+          loop_probe_sent_.store(0);
+        }
         env_->performance_state()->Mark(
             node::performance::NODE_PERFORMANCE_MILESTONE_LOOP_EXIT);
       }
@@ -395,8 +464,12 @@ void Worker::CreateEnvMessagePort(Environment* env) {
 void Worker::JoinThread() {
   if (thread_joined_)
     return;
+  // Take the last reading while the thread can still be queried.
+  GetThreadCpuTime();
   CHECK_EQ(uv_thread_join(&tid_), 0);
   thread_joined_ = true;
+  stop_time_ = uv_hrtime();
+  StopLimitsTimer();
 
   env()->remove_sub_worker_context(this);
 
@@ -633,6 +706,8 @@ void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
     // collected until that finishes.
     w->ClearWeak();
     w->thread_joined_ = false;
+    w->start_time_ = uv_hrtime();
+    w->StartLimitsTimer();
 
     if (w->has_ref_)
       w->env()->add_refs(1);
@@ -692,6 +767,126 @@ Local<Float64Array> Worker::GetResourceLimits(Isolate* isolate) const {
   return Float64Array::New(ab, 0, kTotalResourceLimitCount);
 }
 
+void Worker::StartLimitsTimer() {
+  double limit = 0;
+  for (int index : { kMaxCpuTimeMs, kMaxEventLoopDelayMs }) {
+    if (resource_limits_[index] > 0 && std::isfinite(resource_limits_[index]) &&
+        (limit == 0 || resource_limits_[index] < limit)) {
+      limit = resource_limits_[index];
+    }
+  }
+  if (limit == 0) return;
+
+  // Check a few times per limit period, so that the limits are not exceeded
+  // by much before the thread is stopped.
+  const uint64_t interval = std::min(std::max(limit / 4, 1.0), 100.0);
+  limits_timer_ = new uv_timer_t();
+  CHECK_EQ(uv_timer_init(env()->event_loop(), limits_timer_), 0);
+  limits_timer_->data = this;
+  CHECK_EQ(uv_timer_start(limits_timer_, [](uv_timer_t* handle) {
+    static_cast<Worker*>(handle->data)->CheckLimits();
+  }, interval, interval), 0);
+  uv_unref(reinterpret_cast<uv_handle_t*>(limits_timer_));
+}
+
+void Worker::StopLimitsTimer() {
+  if (limits_timer_ == nullptr) return;
+  env()->CloseHandle(limits_timer_, [](uv_timer_t* handle) {
+    delete handle;
+  });
+  limits_timer_ = nullptr;
+}
+
+void Worker::CheckLimits() {
+  const double max_cpu_time = resource_limits_[kMaxCpuTimeMs];
+  if (max_cpu_time > 0 && GetThreadCpuTime() > max_cpu_time * 1e6) {
+    uv_timer_stop(limits_timer_);
+    std::string reason = std::to_string(static_cast<int64_t>(max_cpu_time));
+    Exit(1, "ERR_WORKER_CPU_LIMIT", (reason + " ms").c_str());
+    return;
+  }
+
+  const double max_delay = resource_limits_[kMaxEventLoopDelayMs];
+  if (max_delay > 0) {
+    const uint64_t now = uv_hrtime();
+    bool blocked = false;
+    {
+      Mutex::ScopedLock lock(mutex_);
+      if (loop_probe_ == nullptr) return;
+      const uint64_t sent = loop_probe_sent_.load();
+      if (sent == 0) {
+        loop_probe_sent_.store(now);
+        uv_async_send(loop_probe_);
+      } else {
+        blocked = now - sent > max_delay * 1e6;
+      }
+    }
+    if (blocked) {
+      uv_timer_stop(limits_timer_);
+      std::string reason = std::to_string(static_cast<int64_t>(max_delay));
+      Exit(1, "ERR_WORKER_EVENT_LOOP_BLOCKED",
+           ("for more than " + reason + " ms").c_str());
+    }
+  }
+}
+
+uint64_t Worker::GetThreadCpuTime() {
+  if (thread_joined_ || start_time_ == 0)
+    return cpu_time_;
+#ifdef _WIN32
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (::GetThreadTimes(tid_,
+                       &creation_time,
+                       &exit_time,
+                       &kernel_time,
+                       &user_time)) {
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart = kernel_time.dwLowDateTime;
+    kernel.HighPart = kernel_time.dwHighDateTime;
+    user.LowPart = user_time.dwLowDateTime;
+    user.HighPart = user_time.dwHighDateTime;
+    // FILETIME values are in units of 100 nanoseconds.
+    cpu_time_ = (kernel.QuadPart + user.QuadPart) * 100;
+  }
+#elif defined(__APPLE__)
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+  if (thread_info(pthread_mach_thread_np(tid_),
+                  THREAD_BASIC_INFO,
+                  reinterpret_cast<thread_info_t>(&info),
+                  &count) == KERN_SUCCESS) {
+    cpu_time_ =
+        (info.user_time.seconds + info.system_time.seconds) * 1000000000ull +
+        (info.user_time.microseconds + info.system_time.microseconds) * 1000ull;
+  }
+#else
+  clockid_t clock;
+  struct timespec ts;
+  if (pthread_getcpuclockid(tid_, &clock) == 0 &&
+      clock_gettime(clock, &ts) == 0) {
+    cpu_time_ = ts.tv_sec * 1000000000ull + ts.tv_nsec;
+  }
+#endif
+  return cpu_time_;
+}
+
+void Worker::GetCpuUsage(const FunctionCallbackInfo<Value>& args) {
+  Worker* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
+  Isolate* isolate = args.GetIsolate();
+
+  uint64_t elapsed = 0;
+  if (w->start_time_ != 0) {
+    elapsed =
+        (w->thread_joined_ ? w->stop_time_ : uv_hrtime()) - w->start_time_;
+  }
+  Local<Value> values[] = {
+    Number::New(isolate, elapsed / 1e6),
+    Number::New(isolate, w->GetThreadCpuTime() / 1e6)
+  };
+  args.GetReturnValue().Set(Array::New(isolate, values, arraysize(values)));
+}
+
 void Worker::Exit(int code, const char* error_code, const char* error_message) {
   Mutex::ScopedLock lock(mutex_);
   Debug(this, "Worker %llu called Exit(%d, %s, %s)",
@@ -763,6 +958,139 @@ void Worker::TakeHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
 
 namespace {
 
+static Mutex atomics_waiters_mutex;
+class AtomicsWaiter;
+static std::unordered_multimap<std::atomic<int32_t>*, AtomicsWaiter*>
+    atomics_waiters;
+
+// Lets the event loop wait for a change to a slot in a SharedArrayBuffer
+// without blocking the thread, similar to what Atomics.waitAsync() provides.
+// Like V8's own Atomics.wait() implementation, waiters are stored in a
+// process-wide list keyed by address, so that any thread which shares the
+// memory can wake them up through AtomicsWaiter::Notify().
+class AtomicsWaiter : public HandleWrap {
+ public:
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    Environment* env = Environment::GetCurrent(args);
+    new AtomicsWaiter(env, args.This());
+  }
+
+  // wait(int32array, index, value): Start waiting for a notification on
+  // `int32array[index]`, unless it no longer holds `value`. Returns whether
+  // the waiter was registered. `oncomplete` is called once it is woken up.
+  static void Wait(const FunctionCallbackInfo<Value>& args) {
+    AtomicsWaiter* waiter;
+    ASSIGN_OR_RETURN_UNWRAP(&waiter, args.Holder());
+    std::atomic<int32_t>* address = GetAddress(args[0], args[1]);
+    CHECK(args[2]->IsInt32());
+    int32_t value = args[2].As<Int32>()->Value();
+
+    Mutex::ScopedLock lock(atomics_waiters_mutex);
+    waiter->Unregister();
+    if (waiter->IsHandleClosing() || address->load() != value)
+      return args.GetReturnValue().Set(false);
+    atomics_waiters.emplace(address, waiter);
+    waiter->address_ = address;
+    uv_ref(waiter->GetHandle());
+    args.GetReturnValue().Set(true);
+  }
+
+  static void Cancel(const FunctionCallbackInfo<Value>& args) {
+    AtomicsWaiter* waiter;
+    ASSIGN_OR_RETURN_UNWRAP(&waiter, args.Holder());
+    Mutex::ScopedLock lock(atomics_waiters_mutex);
+    waiter->Unregister();
+    uv_unref(waiter->GetHandle());
+  }
+
+  // notify(int32array, index): Wake up all AtomicsWaiters for
+  // `int32array[index]`, on any thread. Returns the number of woken waiters.
+  static void Notify(const FunctionCallbackInfo<Value>& args) {
+    std::atomic<int32_t>* address = GetAddress(args[0], args[1]);
+    uint32_t count = 0;
+
+    Mutex::ScopedLock lock(atomics_waiters_mutex);
+    auto range = atomics_waiters.equal_range(address);
+    for (auto it = range.first; it != range.second; count++) {
+      AtomicsWaiter* waiter = it->second;
+      waiter->address_ = nullptr;
+      CHECK_EQ(uv_async_send(&waiter->async_), 0);
+      it = atomics_waiters.erase(it);
+    }
+    args.GetReturnValue().Set(count);
+  }
+
+  void Close(Local<Value> close_callback) override {
+    {
+      // Make sure that no other thread can call uv_async_send() once the
+      // handle is closing.
+      Mutex::ScopedLock lock(atomics_waiters_mutex);
+      Unregister();
+    }
+    HandleWrap::Close(close_callback);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(AtomicsWaiter)
+  SET_SELF_SIZE(AtomicsWaiter)
+
+ private:
+  AtomicsWaiter(Environment* env, Local<Object> object)
+      : HandleWrap(env,
+                   object,
+                   reinterpret_cast<uv_handle_t*>(&async_),
+                   AsyncWrap::PROVIDER_ATOMICSWAITER) {
+    CHECK_EQ(uv_async_init(env->event_loop(), &async_, OnWake), 0);
+    // The handle only keeps the event loop alive while waiting.
+    uv_unref(GetHandle());
+  }
+
+  static std::atomic<int32_t>* GetAddress(Local<Value> array,
+                                          Local<Value> index) {
+    CHECK(array->IsInt32Array());
+    CHECK(index->IsUint32());
+    Local<Int32Array> view = array.As<Int32Array>();
+    uint32_t offset = index.As<Uint32>()->Value();
+    CHECK(view->Buffer()->IsSharedArrayBuffer());
+    CHECK_LT(offset, view->Length());
+    char* data = static_cast<char*>(view->Buffer()->GetBackingStore()->Data());
+    return reinterpret_cast<std::atomic<int32_t>*>(
+        data + view->ByteOffset() + offset * sizeof(int32_t));
+  }
+
+  // Must be called with atomics_waiters_mutex held.
+  void Unregister() {
+    if (address_ == nullptr) return;
+    auto range = atomics_waiters.equal_range(address_);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == this) {
+        atomics_waiters.erase(it);
+        break;
+      }
+    }
+    address_ = nullptr;
+  }
+
+  static void OnWake(uv_async_t* handle) {
+    AtomicsWaiter* waiter = ContainerOf(&AtomicsWaiter::async_, handle);
+    Environment* env = waiter->env();
+    {
+      Mutex::ScopedLock lock(atomics_waiters_mutex);
+      // A new wait() call may have been made in the meantime.
+      if (waiter->address_ == nullptr)
+        uv_unref(waiter->GetHandle());
+    }
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    waiter->MakeCallback(env->oncomplete_string(), 0, nullptr);
+  }
+
+  uv_async_t async_;
+  // Protected by atomics_waiters_mutex.
+  std::atomic<int32_t>* address_ = nullptr;
+};
+
 // Return the MessagePort that is global for this Environment and communicates
 // with the internal [kPort] port of the JS Worker class in the parent thread.
 void GetEnvMessagePort(const FunctionCallbackInfo<Value>& args) {
@@ -793,6 +1121,7 @@ void InitWorker(Local<Object> target,
     env->SetProtoMethod(w, "ref", Worker::Ref);
     env->SetProtoMethod(w, "unref", Worker::Unref);
     env->SetProtoMethod(w, "getResourceLimits", Worker::GetResourceLimits);
+    env->SetProtoMethod(w, "getCpuUsage", Worker::GetCpuUsage);
     env->SetProtoMethod(w, "takeHeapSnapshot", Worker::TakeHeapSnapshot);
 
     Local<String> workerString =
@@ -816,7 +1145,26 @@ void InitWorker(Local<Object> target,
     env->set_worker_heap_snapshot_taker_template(wst->InstanceTemplate());
   }
 
+  {
+    Local<FunctionTemplate> aw = env->NewFunctionTemplate(AtomicsWaiter::New);
+
+    aw->InstanceTemplate()->SetInternalFieldCount(
+        AtomicsWaiter::kInternalFieldCount);
+    aw->Inherit(HandleWrap::GetConstructorTemplate(env));
+
+    env->SetProtoMethod(aw, "wait", AtomicsWaiter::Wait);
+    env->SetProtoMethod(aw, "cancel", AtomicsWaiter::Cancel);
+
+    Local<String> aw_string =
+        FIXED_ONE_BYTE_STRING(env->isolate(), "AtomicsWaiter");
+    aw->SetClassName(aw_string);
+    target->Set(env->context(),
+                aw_string,
+                aw->GetFunction(env->context()).ToLocalChecked()).Check();
+  }
+
   env->SetMethod(target, "getEnvMessagePort", GetEnvMessagePort);
+  env->SetMethod(target, "atomicsNotify", AtomicsWaiter::Notify);
 
   target
       ->Set(env->context(),
@@ -848,6 +1196,8 @@ void InitWorker(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kMaxOldGenerationSizeMb);
   NODE_DEFINE_CONSTANT(target, kCodeRangeSizeMb);
   NODE_DEFINE_CONSTANT(target, kStackSizeMb);
+  NODE_DEFINE_CONSTANT(target, kMaxCpuTimeMs);
+  NODE_DEFINE_CONSTANT(target, kMaxEventLoopDelayMs);
   NODE_DEFINE_CONSTANT(target, kTotalResourceLimitCount);
 }
 
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
 #include <unordered_map>
 #include "node_messaging.h"
 #include "uv.h"
@@ -17,6 +18,8 @@ enum ResourceLimits {
   kMaxOldGenerationSizeMb,
   kCodeRangeSizeMb,
   kStackSizeMb,
+  kMaxCpuTimeMs,
+  kMaxEventLoopDelayMs,
   kTotalResourceLimitCount
 };
 
@@ -64,6 +67,7 @@ class Worker : public AsyncWrap {
   static void GetResourceLimits(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   v8::Local<v8::Float64Array> GetResourceLimits(v8::Isolate* isolate) const;
+  static void GetCpuUsage(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void TakeHeapSnapshot(const v8::FunctionCallbackInfo<v8::Value>& args);
 
  private:
@@ -71,6 +75,15 @@ class Worker : public AsyncWrap {
   static size_t NearHeapLimit(void* data, size_t current_heap_limit,
                               size_t initial_heap_limit);
 
+  // The CPU time and event loop delay limits are enforced by a timer that
+  // runs on the parent thread.
+  void StartLimitsTimer();
+  void StopLimitsTimer();
+  void CheckLimits();
+  // Returns the CPU time used by the worker thread so far, in nanoseconds.
+  // Only called on the parent thread.
+  uint64_t GetThreadCpuTime();
+
   std::shared_ptr<PerIsolateOptions> per_isolate_opts_;
   std::vector<std::string> exec_argv_;
   std::vector<std::string> argv_;
@@ -91,10 +104,21 @@ class Worker : public AsyncWrap {
   ThreadId thread_id_;
   uintptr_t stack_base_ = 0;
 
+  // Woken up by the parent thread to measure the event loop delay. Only set
+  // while the worker's event loop is running.
+  uv_async_t* loop_probe_ = nullptr;
+  // The time at which the probe was sent, or 0 once it has been handled.
+  std::atomic<uint64_t> loop_probe_sent_ {0};
+
   // Custom resource constraints:
   double resource_limits_[kTotalResourceLimitCount];
   void UpdateResourceConstraints(v8::ResourceConstraints* constraints);
 
+  uv_timer_t* limits_timer_ = nullptr;
+  uint64_t start_time_ = 0;
+  uint64_t stop_time_ = 0;
+  uint64_t cpu_time_ = 0;
+
   // Full size of the thread's stack.
   size_t stack_size_ = 4 * 1024 * 1024;
   // Stack buffer size that is not available to the JS engine.
@@ -23,6 +23,7 @@
 #include "node.h"
 #include "node_buffer.h"
 
+#include "allocated_buffer-inl.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "threadpoolwork-inl.h"
@@ -33,17 +34,28 @@
 #include "brotli/encode.h"
 #include "brotli/decode.h"
 #include "zlib.h"
+// For ZSTD_create{C,D}Ctx_advanced(), which take custom allocators.
+#define ZSTD_STATIC_LINKING_ONLY
+#include "zstd.h"
+#include "zstd_errors.h"
 
 #include <sys/types.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
 #include <atomic>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 namespace node {
 
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
+using v8::BackingStore;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -51,11 +63,20 @@ using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
 using v8::Int32;
+using v8::Int32Array;
 using v8::Integer;
+using v8::Isolate;
+using v8::Just;
 using v8::Local;
+using v8::Maybe;
+using v8::MaybeLocal;
+using v8::Nothing;
 using v8::Object;
 using v8::String;
+using v8::Uint32;
 using v8::Uint32Array;
+using v8::Uint8Array;
+using v8::Undefined;
 using v8::Value;
 
 namespace {
@@ -101,7 +122,9 @@ enum node_zlib_mode {
   INFLATERAW,
   UNZIP,
   BROTLI_DECODE,
-  BROTLI_ENCODE
+  BROTLI_ENCODE,
+  ZSTD_COMPRESS,
+  ZSTD_DECOMPRESS
 };
 
 #define GZIP_HEADER_ID1 0x1f
@@ -124,6 +147,86 @@ struct CompressionError {
   inline bool IsError() const { return code != nullptr; }
 };
 
+// Keeps the initialized zlib streams of closed contexts that were created
+// with `reuseContext`, so that later contexts with the same parameters can
+// take them over after a deflateReset()/inflateReset() instead of allocating
+// and initializing a new stream. The preset dictionaries of those contexts
+// are shared, too.
+// Pooled streams allocate their memory through the pool. The pool is
+// referenced by every context that uses it, so it outlives all of them.
+class ZlibContextPool {
+ public:
+  struct Key {
+    node_zlib_mode mode;
+    int level;
+    int window_bits;
+    int mem_level;
+    int strategy;
+
+    bool operator<(const Key& other) const {
+      return std::tie(mode, level, window_bits, mem_level, strategy) <
+             std::tie(other.mode, other.level, other.window_bits,
+                      other.mem_level, other.strategy);
+    }
+  };
+
+  explicit ZlibContextPool(Isolate* isolate) : isolate_(isolate) {}
+  ~ZlibContextPool();
+
+  ZlibContextPool(const ZlibContextPool&) = delete;
+  ZlibContextPool& operator=(const ZlibContextPool&) = delete;
+
+  // Returns a reset stream for |key|, or nullptr if none is available.
+  std::unique_ptr<z_stream> Acquire(const Key& key);
+  // Resets |*strm| and takes it over, unless the pool is full for |key|.
+  bool Release(const Key& key, std::unique_ptr<z_stream>* strm);
+  // Returns a dictionary with the same contents as |data|, shared with other
+  // contexts if possible.
+  std::shared_ptr<const std::vector<unsigned char>> GetDictionary(
+      std::vector<unsigned char>&& data);
+
+  static void* AllocForZlib(void* data, uInt items, uInt size);
+  static void FreeForZlib(void* data, void* pointer);
+
+  size_t memory() const { return zlib_memory_; }
+
+ private:
+  static bool IsDeflate(node_zlib_mode mode) {
+    return mode == DEFLATE || mode == GZIP || mode == DEFLATERAW;
+  }
+
+  void AdjustAmountOfExternalAllocatedMemory();
+
+  // A limit per set of parameters. Default deflate streams take ~256 KB each.
+  static constexpr size_t kMaxStreamsPerKey = 16;
+
+  Isolate* isolate_;
+  std::map<Key, std::vector<std::unique_ptr<z_stream>>> streams_;
+  std::vector<std::weak_ptr<const std::vector<unsigned char>>> dictionaries_;
+  std::atomic<ssize_t> unreported_allocations_{0};
+  size_t zlib_memory_ = 0;
+};
+
+class BindingData : public BaseObject {
+ public:
+  BindingData(Environment* env, Local<Object> obj)
+      : BaseObject(env, obj),
+        context_pool(std::make_shared<ZlibContextPool>(env->isolate())) {}
+
+  static constexpr FastStringKey binding_data_name { "zlib" };
+
+  std::shared_ptr<ZlibContextPool> context_pool;
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("context_pool", context_pool->memory());
+  }
+  SET_SELF_SIZE(BindingData)
+  SET_MEMORY_INFO_NAME(BindingData)
+};
+
+// TODO(addaleax): Remove once we're on C++17.
+constexpr FastStringKey BindingData::binding_data_name;
+
 class ZlibContext : public MemoryRetainer {
  public:
   ZlibContext() = default;
@@ -142,13 +245,18 @@ class ZlibContext : public MemoryRetainer {
   CompressionError Init(int level, int window_bits, int mem_level, int strategy,
                         std::vector<unsigned char>&& dictionary);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
+  // Makes the context take its stream from |pool| and return it there when
+  // the context is closed. Replaces SetAllocationFunctions().
+  void SetContextPool(std::shared_ptr<ZlibContextPool> pool);
   CompressionError SetParams(int level, int strategy);
+  size_t GetCompressBound(size_t input_length);
 
   SET_MEMORY_INFO_NAME(ZlibContext)
   SET_SELF_SIZE(ZlibContext)
 
   void MemoryInfo(MemoryTracker* tracker) const override {
-    tracker->TrackField("dictionary", dictionary_);
+    if (dictionary_)
+      tracker->TrackField("dictionary", *dictionary_);
   }
 
   ZlibContext(const ZlibContext&) = delete;
@@ -157,6 +265,7 @@ class ZlibContext : public MemoryRetainer {
  private:
   CompressionError ErrorForMessage(const char* message) const;
   CompressionError SetDictionary();
+  bool HasDictionary() const { return dictionary_ && !dictionary_->empty(); }
 
   int err_ = 0;
   int flush_ = 0;
@@ -166,9 +275,14 @@ class ZlibContext : public MemoryRetainer {
   int strategy_ = 0;
   int window_bits_ = 0;
   unsigned int gzip_id_bytes_read_ = 0;
-  std::vector<unsigned char> dictionary_;
+  std::shared_ptr<const std::vector<unsigned char>> dictionary_;
 
-  z_stream strm_;
+  std::shared_ptr<ZlibContextPool> pool_;
+  ZlibContextPool::Key pool_key_ {};
+
+  // zlib's internal state points back to the z_stream, so it lives on the
+  // heap in order to be able to hand it over to the pool.
+  std::unique_ptr<z_stream> strm_ = std::make_unique<z_stream>();
 };
 
 // Brotli has different data types for compression and decompression streams,
@@ -210,6 +324,7 @@ class BrotliEncoderContext final : public BrotliContext {
   CompressionError ResetStream();
   CompressionError SetParams(int key, uint32_t value);
   CompressionError GetErrorInfo() const;
+  size_t GetCompressBound(size_t input_length) const;
 
   SET_MEMORY_INFO_NAME(BrotliEncoderContext)
   SET_SELF_SIZE(BrotliEncoderContext)
@@ -242,6 +357,75 @@ class BrotliDecoderContext final : public BrotliContext {
   DeleteFnPtr<BrotliDecoderState, BrotliDecoderDestroyInstance> state_;
 };
 
+inline void FreeZstdCCtx(ZSTD_CCtx* cctx) { ZSTD_freeCCtx(cctx); }
+inline void FreeZstdDCtx(ZSTD_DCtx* dctx) { ZSTD_freeDCtx(dctx); }
+
+// Like Brotli, zstd has different data types for compression and
+// decompression streams. The flush values passed from JS are
+// ZSTD_EndDirective values, which correspond to the Z_NO_FLUSH, Z_SYNC_FLUSH
+// and Z_FINISH semantics of zlib.
+class ZstdContext : public MemoryRetainer {
+ public:
+  ZstdContext() = default;
+
+  void SetBuffers(char* in, uint32_t in_len, char* out, uint32_t out_len);
+  void SetFlush(int flush);
+  void GetAfterWriteOffsets(uint32_t* avail_in, uint32_t* avail_out) const;
+  inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
+
+  ZstdContext(const ZstdContext&) = delete;
+  ZstdContext& operator=(const ZstdContext&) = delete;
+
+ protected:
+  node_zlib_mode mode_ = NONE;
+  ZSTD_inBuffer input_ = { nullptr, 0, 0 };
+  ZSTD_outBuffer output_ = { nullptr, 0, 0 };
+  ZSTD_EndDirective flush_ = ZSTD_e_continue;
+  // The return value of the last ZSTD_compressStream2() or
+  // ZSTD_decompressStream() call: an error code, or a hint of how much
+  // work is left.
+  size_t last_result_ = 0;
+};
+
+class ZstdCompressContext final : public ZstdContext {
+ public:
+  void Close();
+  void DoThreadPoolWork();
+  CompressionError Init(ZSTD_allocFunction alloc,
+                        ZSTD_freeFunction free,
+                        void* opaque);
+  CompressionError ResetStream();
+  CompressionError SetParams(int key, int value);
+  CompressionError GetErrorInfo() const;
+  size_t GetCompressBound(size_t input_length) const;
+
+  SET_MEMORY_INFO_NAME(ZstdCompressContext)
+  SET_SELF_SIZE(ZstdCompressContext)
+  SET_NO_MEMORY_INFO()  // cctx_ is covered through allocation tracking.
+
+ private:
+  DeleteFnPtr<ZSTD_CCtx, FreeZstdCCtx> cctx_;
+};
+
+class ZstdDecompressContext final : public ZstdContext {
+ public:
+  void Close();
+  void DoThreadPoolWork();
+  CompressionError Init(ZSTD_allocFunction alloc,
+                        ZSTD_freeFunction free,
+                        void* opaque);
+  CompressionError ResetStream();
+  CompressionError SetParams(int key, int value);
+  CompressionError GetErrorInfo() const;
+
+  SET_MEMORY_INFO_NAME(ZstdDecompressContext)
+  SET_SELF_SIZE(ZstdDecompressContext)
+  SET_NO_MEMORY_INFO()  // dctx_ is covered through allocation tracking.
+
+ private:
+  DeleteFnPtr<ZSTD_DCtx, FreeZstdDCtx> dctx_;
+};
+
 template <typename CompressionContext>
 class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  public:
@@ -568,9 +752,9 @@ class ZlibStream : public CompressionStream<ZlibContext> {
           "a version of npm (> 5.5.1 or < 5.4.0) or node-tar (> 4.0.1) "
           "that is compatible with Node.js 9 and above.\n");
     }
-    CHECK(args.Length() == 7 &&
+    CHECK((args.Length() == 7 || args.Length() == 8) &&
       "init(windowBits, level, memLevel, strategy, writeResult, writeCallback,"
-      " dictionary)");
+      " dictionary[, reuseContext])");
 
     ZlibStream* wrap;
     ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -610,11 +794,19 @@ class ZlibStream : public CompressionStream<ZlibContext> {
           data + Buffer::Length(args[6]));
     }
 
+    const bool reuse_context = args.Length() == 8 && args[7]->IsTrue();
+
     wrap->InitStream(write_result, write_js_callback);
 
     AllocScope alloc_scope(wrap);
-    wrap->context()->SetAllocationFunctions(
-        AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
+    if (reuse_context) {
+      BindingData* binding_data =
+          Environment::GetBindingData<BindingData>(args);
+      wrap->context()->SetContextPool(binding_data->context_pool);
+    } else {
+      wrap->context()->SetAllocationFunctions(
+          AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
+    }
     const CompressionError err =
         wrap->context()->Init(level, window_bits, mem_level, strategy,
                               std::move(dictionary));
@@ -723,21 +915,224 @@ class BrotliCompressionStream : public CompressionStream<CompressionContext> {
 using BrotliEncoderStream = BrotliCompressionStream<BrotliEncoderContext>;
 using BrotliDecoderStream = BrotliCompressionStream<BrotliDecoderContext>;
 
+template <typename CompressionContext>
+class ZstdCompressionStream : public CompressionStream<CompressionContext> {
+ public:
+  ZstdCompressionStream(Environment* env,
+                        Local<Object> wrap,
+                        node_zlib_mode mode)
+    : CompressionStream<CompressionContext>(env, wrap) {
+    context()->SetMode(mode);
+  }
+
+  inline CompressionContext* context() {
+    return this->CompressionStream<CompressionContext>::context();
+  }
+  typedef typename CompressionStream<CompressionContext>::AllocScope AllocScope;
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args[0]->IsInt32());
+    node_zlib_mode mode =
+        static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
+    new ZstdCompressionStream(env, args.This(), mode);
+  }
+
+  // init(params, writeResult, writeCallback), where params is an Int32Array
+  // of (key, value) pairs, because zstd parameters are sparse and may be
+  // negative.
+  static void Init(const FunctionCallbackInfo<Value>& args) {
+    ZstdCompressionStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+    CHECK(args.Length() == 3 && "init(params, writeResult, writeCallback)");
+
+    CHECK(args[1]->IsUint32Array());
+    uint32_t* write_result = reinterpret_cast<uint32_t*>(Buffer::Data(args[1]));
+
+    CHECK(args[2]->IsFunction());
+    Local<Function> write_js_callback = args[2].As<Function>();
+    wrap->InitStream(write_result, write_js_callback);
+
+    AllocScope alloc_scope(wrap);
+    CompressionError err =
+        InitContext(wrap->context(),
+                    args[0],
+                    CompressionStream<CompressionContext>::AllocForBrotli,
+                    CompressionStream<CompressionContext>::FreeForZlib,
+                    static_cast<CompressionStream<CompressionContext>*>(wrap));
+    if (err.IsError()) {
+      wrap->EmitError(err);
+      args.GetReturnValue().Set(false);
+      return;
+    }
+
+    args.GetReturnValue().Set(true);
+  }
+
+  static CompressionError InitContext(CompressionContext* ctx,
+                                      Local<Value> params,
+                                      ZSTD_allocFunction alloc,
+                                      ZSTD_freeFunction free,
+                                      void* opaque) {
+    CompressionError err = ctx->Init(alloc, free, opaque);
+    if (err.IsError())
+      return err;
+
+    CHECK(params->IsInt32Array());
+    const int32_t* data = reinterpret_cast<int32_t*>(Buffer::Data(params));
+    size_t len = params.As<Int32Array>()->Length();
+    CHECK_EQ(len % 2, 0);
+    for (size_t i = 0; i < len; i += 2) {
+      err = ctx->SetParams(data[i], data[i + 1]);
+      if (err.IsError())
+        return err;
+    }
+    return CompressionError {};
+  }
+
+  static void Params(const FunctionCallbackInfo<Value>& args) {
+    // Currently a no-op, and not accessed from JS land, like for Brotli.
+  }
+
+  SET_MEMORY_INFO_NAME(ZstdCompressionStream)
+  SET_SELF_SIZE(ZstdCompressionStream)
+};
+
+using ZstdCompressStream = ZstdCompressionStream<ZstdCompressContext>;
+using ZstdDecompressStream = ZstdCompressionStream<ZstdDecompressContext>;
+
+ZlibContextPool::~ZlibContextPool() {
+  // This only happens during Environment teardown, so the memory is not
+  // reported back to V8 anymore.
+  for (auto& entry : streams_) {
+    for (auto& strm : entry.second) {
+      if (IsDeflate(entry.first.mode))
+        deflateEnd(strm.get());
+      else
+        inflateEnd(strm.get());
+    }
+  }
+}
+
+
+std::unique_ptr<z_stream> ZlibContextPool::Acquire(const Key& key) {
+  auto it = streams_.find(key);
+  if (it == streams_.end() || it->second.empty())
+    return nullptr;
+  std::unique_ptr<z_stream> strm = std::move(it->second.back());
+  it->second.pop_back();
+  AdjustAmountOfExternalAllocatedMemory();
+  return strm;
+}
+
+
+bool ZlibContextPool::Release(const Key& key,
+                              std::unique_ptr<z_stream>* strm) {
+  std::vector<std::unique_ptr<z_stream>>& streams = streams_[key];
+  if (streams.size() >= kMaxStreamsPerKey)
+    return false;
+
+  // inflateReset2() also restores the window size that auto-detection
+  // (windowBits == 0) may have changed.
+  int err = IsDeflate(key.mode) ?
+      deflateReset(strm->get()) :
+      inflateReset2(strm->get(), key.window_bits);
+  if (err != Z_OK)
+    return false;
+
+  streams.emplace_back(std::move(*strm));
+  AdjustAmountOfExternalAllocatedMemory();
+  return true;
+}
+
+
+std::shared_ptr<const std::vector<unsigned char>>
+ZlibContextPool::GetDictionary(std::vector<unsigned char>&& data) {
+  std::shared_ptr<const std::vector<unsigned char>> dictionary;
+  for (auto it = dictionaries_.begin(); it != dictionaries_.end();) {
+    std::shared_ptr<const std::vector<unsigned char>> candidate = it->lock();
+    if (!candidate) {
+      it = dictionaries_.erase(it);
+      continue;
+    }
+    if (!dictionary && *candidate == data)
+      dictionary = std::move(candidate);
+    ++it;
+  }
+
+  if (!dictionary) {
+    dictionary =
+        std::make_shared<const std::vector<unsigned char>>(std::move(data));
+    dictionaries_.emplace_back(dictionary);
+  }
+  return dictionary;
+}
+
+
+// Pooled streams may be used by different contexts over their lifetime, so
+// their allocations are accounted for by the pool rather than by the
+// CompressionStream that currently owns them.
+void* ZlibContextPool::AllocForZlib(void* data, uInt items, uInt size) {
+  size_t real_size =
+      MultiplyWithOverflowCheck(static_cast<size_t>(items),
+                                static_cast<size_t>(size)) + sizeof(size_t);
+  ZlibContextPool* pool = static_cast<ZlibContextPool*>(data);
+  char* memory = UncheckedMalloc(real_size);
+  if (UNLIKELY(memory == nullptr)) return nullptr;
+  *reinterpret_cast<size_t*>(memory) = real_size;
+  pool->unreported_allocations_.fetch_add(real_size,
+                                          std::memory_order_relaxed);
+  return memory + sizeof(size_t);
+}
+
+
+void ZlibContextPool::FreeForZlib(void* data, void* pointer) {
+  if (UNLIKELY(pointer == nullptr)) return;
+  ZlibContextPool* pool = static_cast<ZlibContextPool*>(data);
+  char* real_pointer = static_cast<char*>(pointer) - sizeof(size_t);
+  size_t real_size = *reinterpret_cast<size_t*>(real_pointer);
+  pool->unreported_allocations_.fetch_sub(real_size,
+                                          std::memory_order_relaxed);
+  free(real_pointer);
+}
+
+
+void ZlibContextPool::AdjustAmountOfExternalAllocatedMemory() {
+  ssize_t report =
+      unreported_allocations_.exchange(0, std::memory_order_relaxed);
+  if (report == 0) return;
+  CHECK_IMPLIES(report < 0, zlib_memory_ >= static_cast<size_t>(-report));
+  zlib_memory_ += report;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(report);
+}
+
+
 void ZlibContext::Close() {
   CHECK_LE(mode_, UNZIP);
 
+  // Streams that failed in a way that may have left their state inconsistent
+  // are not handed out again.
+  if (pool_ && mode_ != NONE && err_ != Z_STREAM_ERROR && err_ != Z_MEM_ERROR &&
+      pool_->Release(pool_key_, &strm_)) {
+    strm_ = std::make_unique<z_stream>();
+    SetContextPool(std::move(pool_));
+    mode_ = NONE;
+    dictionary_.reset();
+    return;
+  }
+
   int status = Z_OK;
   if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-    status = deflateEnd(&strm_);
+    status = deflateEnd(strm_.get());
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
-    status = inflateEnd(&strm_);
+    status = inflateEnd(strm_.get());
   }
 
   CHECK(status == Z_OK || status == Z_DATA_ERROR);
   mode_ = NONE;
 
-  dictionary_.clear();
+  dictionary_.reset();
 }
 
 
@@ -751,11 +1146,11 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      err_ = deflate(strm_.get(), flush_);
       break;
     case UNZIP:
-      if (strm_.avail_in > 0) {
-        next_expected_header_byte = strm_.next_in;
+      if (strm_->avail_in > 0) {
+        next_expected_header_byte = strm_->next_in;
       }
 
       switch (gzip_id_bytes_read_) {
@@ -768,7 +1163,7 @@ void ZlibContext::DoThreadPoolWork() {
             gzip_id_bytes_read_ = 1;
             next_expected_header_byte++;
 
-            if (strm_.avail_in == 1) {
+            if (strm_->avail_in == 1) {
               // The only available byte was already read.
               break;
             }
@@ -801,20 +1196,20 @@ void ZlibContext::DoThreadPoolWork() {
     case INFLATE:
     case GUNZIP:
     case INFLATERAW:
-      err_ = inflate(&strm_, flush_);
+      err_ = inflate(strm_.get(), flush_);
 
       // If data was encoded with dictionary (INFLATERAW will have it set in
       // SetDictionary, don't repeat that here)
       if (mode_ != INFLATERAW &&
           err_ == Z_NEED_DICT &&
-          !dictionary_.empty()) {
+          HasDictionary()) {
         // Load it
-        err_ = inflateSetDictionary(&strm_,
-                                    dictionary_.data(),
-                                    dictionary_.size());
+        err_ = inflateSetDictionary(strm_.get(),
+                                    dictionary_->data(),
+                                    dictionary_->size());
         if (err_ == Z_OK) {
           // And try to decode again
-          err_ = inflate(&strm_, flush_);
+          err_ = inflate(strm_.get(), flush_);
         } else if (err_ == Z_DATA_ERROR) {
           // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
           // Make it possible for After() to tell a bad dictionary from bad
@@ -823,17 +1218,17 @@ void ZlibContext::DoThreadPoolWork() {
         }
       }
 
-      while (strm_.avail_in > 0 &&
+      while (strm_->avail_in > 0 &&
              mode_ == GUNZIP &&
              err_ == Z_STREAM_END &&
-             strm_.next_in[0] != 0x00) {
+             strm_->next_in[0] != 0x00) {
         // Bytes remain in input buffer. Perhaps this is another compressed
         // member in the same archive, or just trailing garbage.
         // Trailing zero bytes are okay, though, since they are frequently
         // used for padding.
 
         ResetStream();
-        err_ = inflate(&strm_, flush_);
+        err_ = inflate(strm_.get(), flush_);
       }
       break;
     default:
@@ -844,10 +1239,10 @@ void ZlibContext::DoThreadPoolWork() {
 
 void ZlibContext::SetBuffers(char* in, uint32_t in_len,
                              char* out, uint32_t out_len) {
-  strm_.avail_in = in_len;
-  strm_.next_in = reinterpret_cast<Bytef*>(in);
-  strm_.avail_out = out_len;
-  strm_.next_out = reinterpret_cast<Bytef*>(out);
+  strm_->avail_in = in_len;
+  strm_->next_in = reinterpret_cast<Bytef*>(in);
+  strm_->avail_out = out_len;
+  strm_->next_out = reinterpret_cast<Bytef*>(out);
 }
 
 
@@ -858,14 +1253,14 @@ void ZlibContext::SetFlush(int flush) {
 
 void ZlibContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                        uint32_t* avail_out) const {
-  *avail_in = strm_.avail_in;
-  *avail_out = strm_.avail_out;
+  *avail_in = strm_->avail_in;
+  *avail_out = strm_->avail_out;
 }
 
 
 CompressionError ZlibContext::ErrorForMessage(const char* message) const {
-  if (strm_.msg != nullptr)
-    message = strm_.msg;
+  if (strm_->msg != nullptr)
+    message = strm_->msg;
 
   return CompressionError { message, ZlibStrerror(err_), err_ };
 }
@@ -876,14 +1271,14 @@ CompressionError ZlibContext::GetErrorInfo() const {
   switch (err_) {
   case Z_OK:
   case Z_BUF_ERROR:
-    if (strm_.avail_out != 0 && flush_ == Z_FINISH) {
+    if (strm_->avail_out != 0 && flush_ == Z_FINISH) {
       return ErrorForMessage("unexpected end of file");
     }
   case Z_STREAM_END:
     // normal statuses, not fatal
     break;
   case Z_NEED_DICT:
-    if (dictionary_.empty())
+    if (!HasDictionary())
       return ErrorForMessage("Missing dictionary");
     else
       return ErrorForMessage("Bad dictionary");
@@ -903,12 +1298,12 @@ CompressionError ZlibContext::ResetStream() {
     case DEFLATE:
     case DEFLATERAW:
     case GZIP:
-      err_ = deflateReset(&strm_);
+      err_ = deflateReset(strm_.get());
       break;
     case INFLATE:
     case INFLATERAW:
     case GUNZIP:
-      err_ = inflateReset(&strm_);
+      err_ = inflateReset(strm_.get());
       break;
     default:
       break;
@@ -921,12 +1316,26 @@ CompressionError ZlibContext::ResetStream() {
 }
 
 
+size_t ZlibContext::GetCompressBound(size_t input_length) {
+  CHECK(mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW);
+  return deflateBound(strm_.get(), input_length);
+}
+
+
 void ZlibContext::SetAllocationFunctions(alloc_func alloc,
                                          free_func free,
                                          void* opaque) {
-  strm_.zalloc = alloc;
-  strm_.zfree = free;
-  strm_.opaque = opaque;
+  strm_->zalloc = alloc;
+  strm_->zfree = free;
+  strm_->opaque = opaque;
+}
+
+
+void ZlibContext::SetContextPool(std::shared_ptr<ZlibContextPool> pool) {
+  SetAllocationFunctions(ZlibContextPool::AllocForZlib,
+                         ZlibContextPool::FreeForZlib,
+                         pool.get());
+  pool_ = std::move(pool);
 }
 
 
@@ -974,11 +1383,28 @@ CompressionError ZlibContext::Init(
     window_bits_ *= -1;
   }
 
-  switch (mode_) {
+  std::unique_ptr<z_stream> pooled_strm;
+  if (pool_) {
+    bool is_deflate = mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW;
+    // Inflate streams do not depend on the compression parameters.
+    pool_key_ = ZlibContextPool::Key {
+      mode_,
+      is_deflate ? level_ : 0,
+      window_bits_,
+      is_deflate ? mem_level_ : 0,
+      is_deflate ? strategy_ : 0
+    };
+    pooled_strm = pool_->Acquire(pool_key_);
+  }
+
+  switch (pooled_strm ? NONE : mode_) {
+    case NONE:
+      strm_ = std::move(pooled_strm);
+      break;
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
+      err_ = deflateInit2(strm_.get(),
                           level_,
                           Z_DEFLATED,
                           window_bits_,
@@ -989,16 +1415,21 @@ CompressionError ZlibContext::Init(
     case GUNZIP:
     case INFLATERAW:
     case UNZIP:
-      err_ = inflateInit2(&strm_, window_bits_);
+      err_ = inflateInit2(strm_.get(), window_bits_);
       break;
     default:
       UNREACHABLE();
   }
 
-  dictionary_ = std::move(dictionary);
+  if (!dictionary.empty()) {
+    dictionary_ = pool_ ?
+        pool_->GetDictionary(std::move(dictionary)) :
+        std::make_shared<const std::vector<unsigned char>>(
+            std::move(dictionary));
+  }
 
   if (err_ != Z_OK) {
-    dictionary_.clear();
+    dictionary_.reset();
     mode_ = NONE;
     return ErrorForMessage("zlib error");
   }
@@ -1008,7 +1439,7 @@ CompressionError ZlibContext::Init(
 
 
 CompressionError ZlibContext::SetDictionary() {
-  if (dictionary_.empty())
+  if (!HasDictionary())
     return CompressionError {};
 
   err_ = Z_OK;
@@ -1016,16 +1447,16 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateSetDictionary(&strm_,
-                                  dictionary_.data(),
-                                  dictionary_.size());
+      err_ = deflateSetDictionary(strm_.get(),
+                                  dictionary_->data(),
+                                  dictionary_->size());
       break;
     case INFLATERAW:
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
-      err_ = inflateSetDictionary(&strm_,
-                                  dictionary_.data(),
-                                  dictionary_.size());
+      err_ = inflateSetDictionary(strm_.get(),
+                                  dictionary_->data(),
+                                  dictionary_->size());
       break;
     default:
       break;
@@ -1045,7 +1476,7 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateParams(&strm_, level, strategy);
+      err_ = deflateParams(strm_.get(), level, strategy);
       break;
     default:
       break;
@@ -1055,6 +1486,14 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
     return ErrorForMessage("Failed to set parameters");
   }
 
+  // A reset stream keeps its parameters, so it is pooled under the new ones.
+  // On Z_BUF_ERROR, deflateParams() has not applied them yet and the stream
+  // still matches its old key.
+  if ((mode_ == DEFLATE || mode_ == DEFLATERAW) && err_ == Z_OK) {
+    pool_key_.level = level;
+    pool_key_.strategy = strategy;
+  }
+
   return CompressionError {};
 }
 
@@ -1132,6 +1571,11 @@ CompressionError BrotliEncoderContext::SetParams(int key, uint32_t value) {
   }
 }
 
+size_t BrotliEncoderContext::GetCompressBound(size_t input_length) const {
+  // A return value of 0 means that the result does not fit into a size_t.
+  return BrotliEncoderMaxCompressedSize(input_length);
+}
+
 CompressionError BrotliEncoderContext::GetErrorInfo() const {
   if (!last_result_) {
     return CompressionError("Compression failed",
@@ -1213,6 +1657,899 @@ CompressionError BrotliDecoderContext::GetErrorInfo() const {
   }
 }
 
+void ZstdContext::SetBuffers(char* in, uint32_t in_len,
+                             char* out, uint32_t out_len) {
+  input_ = { in, in_len, 0 };
+  output_ = { out, out_len, 0 };
+}
+
+
+void ZstdContext::SetFlush(int flush) {
+  flush_ = static_cast<ZSTD_EndDirective>(flush);
+}
+
+
+void ZstdContext::GetAfterWriteOffsets(uint32_t* avail_in,
+                                       uint32_t* avail_out) const {
+  *avail_in = input_.size - input_.pos;
+  *avail_out = output_.size - output_.pos;
+}
+
+
+void ZstdCompressContext::DoThreadPoolWork() {
+  CHECK_EQ(mode_, ZSTD_COMPRESS);
+  CHECK(cctx_);
+  last_result_ = ZSTD_compressStream2(cctx_.get(), &output_, &input_, flush_);
+}
+
+
+void ZstdCompressContext::Close() {
+  cctx_.reset();
+  mode_ = NONE;
+}
+
+
+CompressionError ZstdCompressContext::Init(ZSTD_allocFunction alloc,
+                                           ZSTD_freeFunction free,
+                                           void* opaque) {
+  last_result_ = 0;
+  cctx_.reset(ZSTD_createCCtx_advanced({ alloc, free, opaque }));
+  if (!cctx_) {
+    return CompressionError("Could not initialize zstd instance",
+                            "ERR_ZLIB_INITIALIZATION_FAILED",
+                            -1);
+  }
+  return CompressionError {};
+}
+
+
+CompressionError ZstdCompressContext::ResetStream() {
+  // Unlike recreating the instance, this keeps the parameters.
+  last_result_ = ZSTD_CCtx_reset(cctx_.get(), ZSTD_reset_session_only);
+  return GetErrorInfo();
+}
+
+
+CompressionError ZstdCompressContext::SetParams(int key, int value) {
+  if (ZSTD_isError(ZSTD_CCtx_setParameter(
+          cctx_.get(), static_cast<ZSTD_cParameter>(key), value))) {
+    return CompressionError("Setting parameter failed",
+                            "ERR_ZSTD_PARAM_SET_FAILED",
+                            -1);
+  }
+  return CompressionError {};
+}
+
+
+size_t ZstdCompressContext::GetCompressBound(size_t input_length) const {
+  // Like for Brotli, 0 means that the result does not fit into a size_t.
+  const size_t bound = ZSTD_compressBound(input_length);
+  return ZSTD_isError(bound) ? 0 : bound;
+}
+
+
+CompressionError ZstdCompressContext::GetErrorInfo() const {
+  if (ZSTD_isError(last_result_)) {
+    return CompressionError(ZSTD_getErrorName(last_result_),
+                            "ERR_ZSTD_COMPRESSION_FAILED",
+                            static_cast<int>(ZSTD_getErrorCode(last_result_)));
+  }
+  return CompressionError {};
+}
+
+
+void ZstdDecompressContext::DoThreadPoolWork() {
+  CHECK_EQ(mode_, ZSTD_DECOMPRESS);
+  CHECK(dctx_);
+  last_result_ = ZSTD_decompressStream(dctx_.get(), &output_, &input_);
+}
+
+
+void ZstdDecompressContext::Close() {
+  dctx_.reset();
+  mode_ = NONE;
+}
+
+
+CompressionError ZstdDecompressContext::Init(ZSTD_allocFunction alloc,
+                                             ZSTD_freeFunction free,
+                                             void* opaque) {
+  last_result_ = 0;
+  dctx_.reset(ZSTD_createDCtx_advanced({ alloc, free, opaque }));
+  if (!dctx_) {
+    return CompressionError("Could not initialize zstd instance",
+                            "ERR_ZLIB_INITIALIZATION_FAILED",
+                            -1);
+  }
+  return CompressionError {};
+}
+
+
+CompressionError ZstdDecompressContext::ResetStream() {
+  last_result_ = ZSTD_DCtx_reset(dctx_.get(), ZSTD_reset_session_only);
+  return GetErrorInfo();
+}
+
+
+CompressionError ZstdDecompressContext::SetParams(int key, int value) {
+  if (ZSTD_isError(ZSTD_DCtx_setParameter(
+          dctx_.get(), static_cast<ZSTD_dParameter>(key), value))) {
+    return CompressionError("Setting parameter failed",
+                            "ERR_ZSTD_PARAM_SET_FAILED",
+                            -1);
+  }
+  return CompressionError {};
+}
+
+
+CompressionError ZstdDecompressContext::GetErrorInfo() const {
+  if (ZSTD_isError(last_result_)) {
+    return CompressionError(ZSTD_getErrorName(last_result_),
+                            "ERR_ZSTD_DECOMPRESSION_FAILED",
+                            static_cast<int>(ZSTD_getErrorCode(last_result_)));
+  } else if (flush_ == ZSTD_e_end &&
+             last_result_ != 0 &&
+             input_.pos == input_.size &&
+             output_.pos < output_.size) {
+    // A frame is incomplete, and there is no more input for it. Match
+    // zlib's behaviour, as zstd doesn't have its own code for this.
+    return CompressionError("unexpected end of file",
+                            "Z_BUF_ERROR",
+                            Z_BUF_ERROR);
+  }
+  return CompressionError {};
+}
+
+
+// Compresses a complete input in a single threadpool job, writing directly
+// into one output buffer that is sized from the worst-case bound of the
+// compressor. This avoids the chunked write loop and the final concatenation
+// that the stream-based convenience methods need.
+template <typename CompressionContext>
+class OneShotCompressionJob final : public AsyncWrap, public ThreadPoolWork {
+ public:
+  OneShotCompressionJob(Environment* env,
+                        Local<Object> wrap,
+                        node_zlib_mode mode,
+                        uint32_t flush,
+                        size_t max_output_length,
+                        std::shared_ptr<BackingStore> store,
+                        size_t offset,
+                        size_t length)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
+        ThreadPoolWork(env),
+        flush_(flush),
+        max_output_length_(max_output_length),
+        store_(std::move(store)),
+        offset_(offset),
+        length_(length) {
+    MakeWeak();
+    ctx_.SetMode(mode);
+  }
+
+  ~OneShotCompressionJob() override {
+    CHECK_EQ(false, in_progress_);
+    if (init_done_)
+      ctx_.Close();
+    AdjustAmountOfExternalAllocatedMemory();
+    CHECK_EQ(zlib_memory_, 0);
+    CHECK_EQ(unreported_allocations_, 0);
+  }
+
+  // new OneShotCompressionJob(mode, flush, maxOutputLength, input)
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    Local<Context> context = env->context();
+    CHECK_EQ(args.Length(), 4);
+
+    uint32_t mode, flush;
+    int64_t max_output_length;
+    if (!args[0]->Uint32Value(context).To(&mode) ||
+        !args[1]->Uint32Value(context).To(&flush) ||
+        !args[2]->IntegerValue(context).To(&max_output_length)) {
+      return;
+    }
+    CHECK(mode == DEFLATE || mode == GZIP || mode == DEFLATERAW ||
+          mode == BROTLI_ENCODE || mode == ZSTD_COMPRESS);
+    CHECK_GE(max_output_length, 0);
+
+    CHECK(args[3]->IsArrayBufferView());
+    Local<ArrayBufferView> input = args[3].As<ArrayBufferView>();
+    // The compression contexts take 32-bit input lengths.
+    CHECK_LE(input->ByteLength(), std::numeric_limits<uint32_t>::max());
+
+    new OneShotCompressionJob(env,
+                              args.This(),
+                              static_cast<node_zlib_mode>(mode),
+                              flush,
+                              static_cast<size_t>(max_output_length),
+                              input->Buffer()->GetBackingStore(),
+                              input->ByteOffset(),
+                              input->ByteLength());
+  }
+
+  // init(windowBits, level, memLevel, strategy, dictionary, reuseContext)
+  // for zlib,
+  // init(params) for brotli and zstd.
+  static void Init(const FunctionCallbackInfo<Value>& args) {
+    OneShotCompressionJob* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+    CHECK(!job->init_done_ && "init called twice");
+    bool ok;
+    Maybe<bool> maybe_ok = job->InitContext(&job->ctx_, args);
+    job->AdjustAmountOfExternalAllocatedMemory();
+    if (!maybe_ok.To(&ok)) return;
+    job->init_done_ = ok;
+    args.GetReturnValue().Set(ok);
+  }
+
+  static void Run(const FunctionCallbackInfo<Value>& args) {
+    OneShotCompressionJob* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+    // An allocation failure is reported through `onerror` once the
+    // (then no-op) work item completes, so that the callback stays async.
+    job->AllocateOutput();
+    job->in_progress_ = true;
+    job->ClearWeak();
+    job->ScheduleWork();
+  }
+
+  static void RunSync(const FunctionCallbackInfo<Value>& args) {
+    OneShotCompressionJob* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+    job->AsyncWrap::env()->PrintSyncTrace();
+    if (job->AllocateOutput())
+      while (!job->Compress() && job->GrowOutput()) {}
+    Local<Value> result;
+    if (job->TakeResult().ToLocal(&result))
+      args.GetReturnValue().Set(result);
+  }
+
+  void DoThreadPoolWork() override {
+    if (!allocation_failed_)
+      done_ = Compress();
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    CHECK_EQ(status, 0);
+    Environment* env = AsyncWrap::env();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    if (!allocation_failed_ && !done_ && GrowOutput()) {
+      ScheduleWork();
+      return;
+    }
+
+    in_progress_ = false;
+    auto on_scope_leave = OnScopeLeave([&]() { MakeWeak(); });
+    Local<Value> result;
+    if (TakeResult().ToLocal(&result))
+      MakeCallback(env->ondone_string(), 1, &result);
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("compression context", ctx_);
+    tracker->TrackFieldWithSize("zlib_memory",
+                                zlib_memory_ + unreported_allocations_);
+    tracker->TrackFieldWithSize("output", output_.size);
+  }
+
+  SET_MEMORY_INFO_NAME(OneShotCompressionJob)
+  SET_SELF_SIZE(OneShotCompressionJob)
+
+ private:
+  Maybe<bool> InitContext(ZlibContext* ctx,
+                          const FunctionCallbackInfo<Value>& args) {
+    Local<Context> context = AsyncWrap::env()->context();
+    CHECK_EQ(args.Length(), 6);
+    uint32_t window_bits, mem_level, strategy;
+    int32_t level;
+    if (!args[0]->Uint32Value(context).To(&window_bits) ||
+        !args[1]->Int32Value(context).To(&level) ||
+        !args[2]->Uint32Value(context).To(&mem_level) ||
+        !args[3]->Uint32Value(context).To(&strategy)) {
+      return Nothing<bool>();
+    }
+
+    std::vector<unsigned char> dictionary;
+    if (Buffer::HasInstance(args[4])) {
+      unsigned char* data =
+          reinterpret_cast<unsigned char*>(Buffer::Data(args[4]));
+      dictionary = std::vector<unsigned char>(
+          data,
+          data + Buffer::Length(args[4]));
+    }
+
+    if (args[5]->IsTrue()) {
+      BindingData* binding_data =
+          Environment::GetBindingData<BindingData>(args);
+      ctx->SetContextPool(binding_data->context_pool);
+    } else {
+      ctx->SetAllocationFunctions(AllocForZlib, FreeForZlib, this);
+    }
+    return Just(!ctx->Init(level, window_bits, mem_level, strategy,
+                           std::move(dictionary)).IsError());
+  }
+
+  Maybe<bool> InitContext(BrotliEncoderContext* ctx,
+                          const FunctionCallbackInfo<Value>& args) {
+    CHECK_EQ(args.Length(), 1);
+    if (ctx->Init(AllocForBrotli, FreeForZlib, this).IsError())
+      return Just(false);
+
+    CHECK(args[0]->IsUint32Array());
+    const uint32_t* data = reinterpret_cast<uint32_t*>(Buffer::Data(args[0]));
+    size_t len = args[0].As<Uint32Array>()->Length();
+    for (size_t i = 0; i < len; i++) {
+      if (data[i] == static_cast<uint32_t>(-1))
+        continue;
+      if (ctx->SetParams(i, data[i]).IsError()) {
+        ctx->Close();
+        return Just(false);
+      }
+    }
+    return Just(true);
+  }
+
+  Maybe<bool> InitContext(ZstdCompressContext* ctx,
+                          const FunctionCallbackInfo<Value>& args) {
+    CHECK_EQ(args.Length(), 1);
+    if (ZstdCompressStream::InitContext(ctx,
+                                        args[0],
+                                        AllocForBrotli,
+                                        FreeForZlib,
+                                        this).IsError()) {
+      ctx->Close();
+      return Just(false);
+    }
+    return Just(true);
+  }
+
+  // Same as CompressionStream::AllocForZlib() and friends: the compressor
+  // runs on the threadpool, so its memory is reported to V8 afterwards from
+  // the main thread.
+  static void* AllocForZlib(void* data, uInt items, uInt size) {
+    size_t real_size =
+        MultiplyWithOverflowCheck(static_cast<size_t>(items),
+                                  static_cast<size_t>(size));
+    return AllocForBrotli(data, real_size);
+  }
+
+  static void* AllocForBrotli(void* data, size_t size) {
+    size += sizeof(size_t);
+    OneShotCompressionJob* job = static_cast<OneShotCompressionJob*>(data);
+    char* memory = UncheckedMalloc(size);
+    if (UNLIKELY(memory == nullptr)) return nullptr;
+    *reinterpret_cast<size_t*>(memory) = size;
+    job->unreported_allocations_.fetch_add(size,
+                                           std::memory_order_relaxed);
+    return memory + sizeof(size_t);
+  }
+
+  static void FreeForZlib(void* data, void* pointer) {
+    if (UNLIKELY(pointer == nullptr)) return;
+    OneShotCompressionJob* job = static_cast<OneShotCompressionJob*>(data);
+    char* real_pointer = static_cast<char*>(pointer) - sizeof(size_t);
+    size_t real_size = *reinterpret_cast<size_t*>(real_pointer);
+    job->unreported_allocations_.fetch_sub(real_size,
+                                           std::memory_order_relaxed);
+    free(real_pointer);
+  }
+
+  void AdjustAmountOfExternalAllocatedMemory() {
+    ssize_t report =
+        unreported_allocations_.exchange(0, std::memory_order_relaxed);
+    if (report == 0) return;
+    CHECK_IMPLIES(report < 0, zlib_memory_ >= static_cast<size_t>(-report));
+    zlib_memory_ += report;
+    AsyncWrap::env()->isolate()->AdjustAmountOfExternalAllocatedMemory(report);
+  }
+
+  // The output never needs to hold more than one byte beyond the maximum
+  // output length, which is enough to tell that the limit was exceeded.
+  size_t OutputLimit() const {
+    return std::min<size_t>(max_output_length_,
+                            std::numeric_limits<uint32_t>::max() - 1) + 1;
+  }
+
+  // Allocates the output buffer from the worst-case bound of the compressor,
+  // capped by the maximum output length. The memory is not taken from V8's
+  // heap limit, so that a failed allocation can be reported as an error
+  // rather than aborting the process.
+  bool AllocateOutput() {
+    CHECK(init_done_ && "run before init");
+    CHECK_NULL(output_.data);
+    size_t size = ctx_.GetCompressBound(length_);
+    if (size == 0 || size > OutputLimit())
+      size = OutputLimit();
+    char* data = UncheckedMalloc(size);
+    if (data == nullptr) {
+      allocation_failed_ = true;
+      return false;
+    }
+    output_ = MallocedBuffer<char>(data, size);
+    return true;
+  }
+
+  // Returns false if the output cannot or may not grow any further, in which
+  // case the result is reported as exceeding the maximum output length, or
+  // as an allocation failure.
+  bool GrowOutput() {
+    const size_t size = output_.size;
+    if (size >= OutputLimit()) {
+      output_too_large_ = true;
+      return false;
+    }
+    const size_t new_size = std::min(size + size / 2 + 64, OutputLimit());
+    char* data = UncheckedRealloc(output_.data, new_size);
+    if (data == nullptr) {
+      allocation_failed_ = true;
+      return false;
+    }
+    output_.release();
+    output_ = MallocedBuffer<char>(data, new_size);
+    return true;
+  }
+
+  // Returns true once the input has been consumed and the stream has been
+  // finished (or an error occurred), and false if more output space is
+  // needed.
+  bool Compress() {
+    const uint32_t in_len = length_ - consumed_;
+    const uint32_t out_len = output_.size - written_;
+    ctx_.SetBuffers(static_cast<char*>(store_->Data()) + offset_ + consumed_,
+                    in_len,
+                    output_.data + written_,
+                    out_len);
+    ctx_.SetFlush(flush_);
+    ctx_.DoThreadPoolWork();
+
+    uint32_t avail_in, avail_out;
+    ctx_.GetAfterWriteOffsets(&avail_in, &avail_out);
+    consumed_ += in_len - avail_in;
+    written_ += out_len - avail_out;
+    return avail_out != 0 || ctx_.GetErrorInfo().IsError();
+  }
+
+  // Returns the compressed data, or undefined if it exceeds the maximum
+  // output length. Errors are reported through the `onerror` callback.
+  MaybeLocal<Value> TakeResult() {
+    Environment* env = AsyncWrap::env();
+    const CompressionError err = allocation_failed_ ?
+        CompressionError("Failed to allocate memory",
+                         "ERR_MEMORY_ALLOCATION_FAILED",
+                         -1) :
+        ctx_.GetErrorInfo();
+    // Release the context right away rather than on garbage collection, so
+    // that a pooled zlib stream can be used by the next job.
+    ctx_.Close();
+    init_done_ = false;
+    AdjustAmountOfExternalAllocatedMemory();
+    if (err.IsError()) {
+      Local<Value> argv[] = {
+        OneByteString(env->isolate(), err.message),
+        Integer::New(env->isolate(), err.err),
+        OneByteString(env->isolate(), err.code)
+      };
+      MakeCallback(env->onerror_string(), arraysize(argv), argv);
+      return Undefined(env->isolate());
+    }
+
+    if (output_too_large_ || written_ > max_output_length_) {
+      output_ = MallocedBuffer<char>();
+      return Undefined(env->isolate());
+    }
+
+    // Give back the unused part of the buffer. If shrinking fails, the
+    // original allocation is still valid and is used as is.
+    if (written_ > 0 && written_ < output_.size) {
+      char* data = UncheckedRealloc(output_.data, written_);
+      if (data != nullptr) {
+        output_.release();
+        output_ = MallocedBuffer<char>(data, written_);
+      }
+    }
+    std::unique_ptr<BackingStore> bs = ArrayBuffer::NewBackingStore(
+        output_.release(),
+        written_,
+        [](void* data, size_t length, void* deleter_data) { free(data); },
+        nullptr);
+    Local<ArrayBuffer> ab = ArrayBuffer::New(env->isolate(), std::move(bs));
+    return Buffer::New(env, ab, 0, written_).FromMaybe(Local<Uint8Array>());
+  }
+
+  const uint32_t flush_;
+  const size_t max_output_length_;
+  std::shared_ptr<BackingStore> store_;
+  const size_t offset_;
+  const size_t length_;
+
+  bool init_done_ = false;
+  bool in_progress_ = false;
+  bool done_ = false;
+  bool output_too_large_ = false;
+  bool allocation_failed_ = false;
+  size_t consumed_ = 0;
+  size_t written_ = 0;
+  std::atomic<ssize_t> unreported_allocations_{0};
+  size_t zlib_memory_ = 0;
+  MallocedBuffer<char> output_;
+  CompressionContext ctx_;
+};
+
+using ZlibOneShotJob = OneShotCompressionJob<ZlibContext>;
+using BrotliOneShotJob = OneShotCompressionJob<BrotliEncoderContext>;
+using ZstdOneShotJob = OneShotCompressionJob<ZstdCompressContext>;
+
+// Compresses a single buffer into a gzip, zlib or raw deflate stream by
+// splitting it into blocks that are deflated concurrently on the threadpool.
+// Every block is primed with the window of input that precedes it and, except
+// for the last one, ends with a sync flush, so that the raw deflate data of
+// all blocks can be concatenated into one valid stream. The checksums of the
+// blocks are combined into the one that covers the whole input.
+class ParallelDeflateJob final : public AsyncWrap {
+ public:
+  ParallelDeflateJob(Environment* env,
+                     Local<Object> wrap,
+                     node_zlib_mode mode,
+                     int level,
+                     int window_bits,
+                     int mem_level,
+                     int strategy,
+                     size_t block_size,
+                     size_t concurrency,
+                     size_t max_output_length,
+                     std::shared_ptr<BackingStore> store,
+                     size_t offset,
+                     size_t length)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
+        mode_(mode),
+        level_(level),
+        window_bits_(window_bits),
+        mem_level_(mem_level),
+        strategy_(strategy),
+        block_size_(block_size),
+        concurrency_(concurrency),
+        max_output_length_(max_output_length),
+        store_(std::move(store)),
+        offset_(offset),
+        length_(length) {
+    MakeWeak();
+  }
+
+  // new ParallelDeflateJob(mode, level, windowBits, memLevel, strategy,
+  //                        blockSize, concurrency, maxOutputLength, buffer)
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    Local<Context> context = env->context();
+    CHECK_EQ(args.Length(), 9);
+
+    uint32_t mode;
+    int32_t level;
+    uint32_t window_bits, mem_level, strategy, block_size, concurrency;
+    int64_t max_output_length;
+    if (!args[0]->Uint32Value(context).To(&mode) ||
+        !args[1]->Int32Value(context).To(&level) ||
+        !args[2]->Uint32Value(context).To(&window_bits) ||
+        !args[3]->Uint32Value(context).To(&mem_level) ||
+        !args[4]->Uint32Value(context).To(&strategy) ||
+        !args[5]->Uint32Value(context).To(&block_size) ||
+        !args[6]->Uint32Value(context).To(&concurrency) ||
+        !args[7]->IntegerValue(context).To(&max_output_length)) {
+      return;
+    }
+
+    CHECK(mode == DEFLATE || mode == GZIP || mode == DEFLATERAW);
+    CHECK(level >= Z_MIN_LEVEL && level <= Z_MAX_LEVEL);
+    CHECK(window_bits >= Z_MIN_WINDOWBITS && window_bits <= Z_MAX_WINDOWBITS);
+    CHECK(mem_level >= Z_MIN_MEMLEVEL && mem_level <= Z_MAX_MEMLEVEL);
+    CHECK_GT(block_size, 0);
+    CHECK_GT(concurrency, 0);
+    CHECK_GE(max_output_length, 0);
+
+    CHECK(args[8]->IsArrayBufferView());
+    Local<ArrayBufferView> input = args[8].As<ArrayBufferView>();
+
+    // zlib does not support 256-byte windows for raw deflate streams, and
+    // silently upgrades them to 512 bytes for the other formats.
+    if (window_bits == 8) window_bits = 9;
+
+    new ParallelDeflateJob(env,
+                           args.This(),
+                           static_cast<node_zlib_mode>(mode),
+                           level,
+                           window_bits,
+                           mem_level,
+                           strategy,
+                           block_size,
+                           concurrency,
+                           static_cast<size_t>(max_output_length),
+                           input->Buffer()->GetBackingStore(),
+                           input->ByteOffset(),
+                           input->ByteLength());
+  }
+
+  static void Run(const FunctionCallbackInfo<Value>& args) {
+    ParallelDeflateJob* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+    job->Run();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("output", output_length_);
+  }
+
+  SET_MEMORY_INFO_NAME(ParallelDeflateJob)
+  SET_SELF_SIZE(ParallelDeflateJob)
+
+ private:
+  class Block final : public ThreadPoolWork {
+   public:
+    Block(ParallelDeflateJob* job,
+          const Bytef* data,
+          size_t length,
+          size_t window,
+          bool last)
+        : ThreadPoolWork(job->env()),
+          job_(job),
+          data_(data),
+          length_(length),
+          window_(window),
+          last_(last) {}
+
+    void DoThreadPoolWork() override;
+
+    void AfterThreadPoolWork(int status) override {
+      CHECK_EQ(status, 0);
+      job_->OnBlockDone(this);
+    }
+
+    int error() const { return err_; }
+    uLong checksum() const { return checksum_; }
+    size_t length() const { return length_; }
+    const std::vector<Bytef>& output() const { return output_; }
+
+   private:
+    ParallelDeflateJob* job_;
+    const Bytef* data_;
+    size_t length_;
+    size_t window_;
+    bool last_;
+    int err_ = Z_OK;
+    uLong checksum_ = 0;
+    std::vector<Bytef> output_;
+  };
+
+  void Run();
+  void ScheduleNextBlock();
+  void OnBlockDone(Block* block);
+  void Finish();
+  size_t HeaderLength() const {
+    return mode_ == GZIP ? 10 : mode_ == DEFLATE ? 2 : 0;
+  }
+  size_t TrailerLength() const {
+    return mode_ == GZIP ? 8 : mode_ == DEFLATE ? 4 : 0;
+  }
+  size_t WriteHeader(Bytef* out) const;
+  size_t WriteTrailer(Bytef* out, uLong checksum) const;
+
+  const node_zlib_mode mode_;
+  const int level_;
+  const int window_bits_;
+  const int mem_level_;
+  const int strategy_;
+  const size_t block_size_;
+  const size_t concurrency_;
+  const size_t max_output_length_;
+  std::shared_ptr<BackingStore> store_;
+  const size_t offset_;
+  const size_t length_;
+
+  std::vector<std::unique_ptr<Block>> blocks_;
+  size_t next_block_ = 0;
+  size_t running_ = 0;
+  size_t output_length_ = 0;
+  int err_ = Z_OK;
+};
+
+void ParallelDeflateJob::Run() {
+  CHECK(blocks_.empty() && "job already started");
+  CHECK_GT(length_, 0);
+
+  const Bytef* data = static_cast<const Bytef*>(store_->Data()) + offset_;
+  const size_t window_size = size_t{1} << window_bits_;
+  for (size_t start = 0; start < length_; start += block_size_) {
+    const size_t length = std::min(block_size_, length_ - start);
+    blocks_.emplace_back(std::make_unique<Block>(
+        this,
+        data + start,
+        length,
+        std::min(start, window_size),
+        start + length == length_));
+  }
+
+  ClearWeak();
+  while (running_ < concurrency_ && next_block_ < blocks_.size())
+    ScheduleNextBlock();
+}
+
+void ParallelDeflateJob::ScheduleNextBlock() {
+  running_++;
+  blocks_[next_block_++]->ScheduleWork();
+}
+
+void ParallelDeflateJob::Block::DoThreadPoolWork() {
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+
+  err_ = deflateInit2(&strm,
+                      job_->level_,
+                      Z_DEFLATED,
+                      -job_->window_bits_,
+                      job_->mem_level_,
+                      job_->strategy_);
+  if (err_ != Z_OK) return;
+
+  if (window_ > 0)
+    err_ = deflateSetDictionary(&strm, data_ - window_, window_);
+
+  if (err_ == Z_OK) {
+    const int flush = last_ ? Z_FINISH : Z_SYNC_FLUSH;
+    strm.next_in = const_cast<Bytef*>(data_);
+    strm.avail_in = length_;
+    // deflateBound() does not include the empty stored block that is emitted
+    // by the sync flush, so leave some room for it.
+    output_.resize(deflateBound(&strm, length_) + 16);
+
+    for (;;) {
+      strm.next_out = output_.data() + strm.total_out;
+      strm.avail_out = output_.size() - strm.total_out;
+      err_ = deflate(&strm, flush);
+      if (err_ == Z_STREAM_ERROR) break;
+      if (flush == Z_FINISH ? err_ == Z_STREAM_END : strm.avail_out != 0) {
+        err_ = Z_OK;
+        break;
+      }
+      output_.resize(output_.size() + output_.size() / 2);
+    }
+    output_.resize(strm.total_out);
+  }
+
+  deflateEnd(&strm);
+
+  if (job_->mode_ == GZIP)
+    checksum_ = crc32(0, data_, length_);
+  else if (job_->mode_ == DEFLATE)
+    checksum_ = adler32(1, data_, length_);
+}
+
+void ParallelDeflateJob::OnBlockDone(Block* block) {
+  CHECK_GT(running_, 0);
+  running_--;
+
+  if (block->error() != Z_OK && err_ == Z_OK)
+    err_ = block->error();
+  output_length_ += block->output().size();
+
+  if (err_ == Z_OK && next_block_ < blocks_.size()) {
+    ScheduleNextBlock();
+    return;
+  }
+
+  if (running_ == 0)
+    Finish();
+}
+
+size_t ParallelDeflateJob::WriteHeader(Bytef* out) const {
+  const int level = level_ == Z_DEFAULT_COMPRESSION ? 6 : level_;
+  if (mode_ == GZIP) {
+    // The same header that zlib itself writes when no gz_header is set.
+    const Bytef header[] = {
+      GZIP_HEADER_ID1, GZIP_HEADER_ID2, Z_DEFLATED,
+      0, 0, 0, 0, 0,
+      static_cast<Bytef>(level == 9 ? 2 :
+          (strategy_ >= Z_HUFFMAN_ONLY || level < 2 ? 4 : 0)),
+#ifdef _WIN32
+      10
+#else
+      3
+#endif
+    };
+    static_assert(sizeof(header) == 10, "unexpected gzip header length");
+    memcpy(out, header, sizeof(header));
+    return sizeof(header);
+  }
+  if (mode_ == DEFLATE) {
+    int level_flags;
+    if (strategy_ >= Z_HUFFMAN_ONLY || level < 2)
+      level_flags = 0;
+    else if (level < 6)
+      level_flags = 1;
+    else if (level == 6)
+      level_flags = 2;
+    else
+      level_flags = 3;
+    unsigned header = (Z_DEFLATED + ((window_bits_ - 8) << 4)) << 8;
+    header |= level_flags << 6;
+    header += 31 - (header % 31);
+    out[0] = header >> 8;
+    out[1] = header & 0xff;
+    return 2;
+  }
+  return 0;
+}
+
+size_t ParallelDeflateJob::WriteTrailer(Bytef* out, uLong checksum) const {
+  if (mode_ == GZIP) {
+    const uint32_t length = static_cast<uint32_t>(length_);
+    for (int i = 0; i < 4; i++) {
+      out[i] = (checksum >> (8 * i)) & 0xff;
+      out[4 + i] = (length >> (8 * i)) & 0xff;
+    }
+    return 8;
+  }
+  if (mode_ == DEFLATE) {
+    for (int i = 0; i < 4; i++)
+      out[i] = (checksum >> (8 * (3 - i))) & 0xff;
+    return 4;
+  }
+  return 0;
+}
+
+void ParallelDeflateJob::Finish() {
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  auto on_scope_leave = OnScopeLeave([&]() {
+    blocks_.clear();
+    output_length_ = 0;
+    MakeWeak();
+  });
+
+  if (err_ != Z_OK) {
+    Local<Value> argv[] = {
+      OneByteString(env->isolate(), "Zlib error"),
+      Integer::New(env->isolate(), err_),
+      OneByteString(env->isolate(), ZlibStrerror(err_))
+    };
+    MakeCallback(env->onerror_string(), arraysize(argv), argv);
+    return;
+  }
+
+  const size_t total =
+      HeaderLength() + output_length_ + TrailerLength();
+  Local<Value> result = Undefined(env->isolate());
+  if (total <= max_output_length_) {
+    Local<Object> buffer;
+    if (!Buffer::New(env, total).ToLocal(&buffer))
+      return;
+    Bytef* out = reinterpret_cast<Bytef*>(Buffer::Data(buffer));
+    size_t pos = WriteHeader(out);
+    uLong checksum = mode_ == DEFLATE ? adler32(0, Z_NULL, 0) : 0;
+    for (const auto& block : blocks_) {
+      const std::vector<Bytef>& output = block->output();
+      if (!output.empty())
+        memcpy(out + pos, output.data(), output.size());
+      pos += output.size();
+      if (mode_ == GZIP) {
+        checksum = crc32_combine(checksum, block->checksum(), block->length());
+      } else if (mode_ == DEFLATE) {
+        checksum =
+            adler32_combine(checksum, block->checksum(), block->length());
+      }
+    }
+    pos += WriteTrailer(out + pos, checksum);
+    CHECK_EQ(pos, total);
+    result = buffer;
+  }
+
+  // The result is undefined if it would exceed maxOutputLength.
+  MakeCallback(env->ondone_string(), 1, &result);
+}
+
 
 template <typename Stream>
 struct MakeClass {
@@ -1239,15 +2576,96 @@ struct MakeClass {
   }
 };
 
+template <typename Job>
+void MakeOneShotJobClass(Environment* env,
+                         Local<Object> target,
+                         const char* name) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(Job::New);
+  t->InstanceTemplate()->SetInternalFieldCount(Job::kInternalFieldCount);
+  t->Inherit(AsyncWrap::GetConstructorTemplate(env));
+
+  env->SetProtoMethod(t, "init", Job::Init);
+  env->SetProtoMethod(t, "run", Job::Run);
+  env->SetProtoMethod(t, "runSync", Job::RunSync);
+
+  Local<String> class_name = OneByteString(env->isolate(), name);
+  t->SetClassName(class_name);
+  target->Set(env->context(),
+              class_name,
+              t->GetFunction(env->context()).ToLocalChecked()).Check();
+}
+
+// The checksum functions take 32-bit lengths, and the ARMv8 CRC32 path in
+// deps/zlib is only reachable through crc32() rather than crc32_z().
+template <uLong (*Checksum)(uLong, const Bytef*, uInt)>
+uint32_t UpdateChecksum(uint32_t value, const char* data, size_t length) {
+  constexpr size_t kMaxChunk = 1 << 30;
+  while (length > 0) {
+    const size_t chunk = std::min(length, kMaxChunk);
+    value = Checksum(value, reinterpret_cast<const Bytef*>(data), chunk);
+    data += chunk;
+    length -= chunk;
+  }
+  return value;
+}
+
+// crc32(data, value) and adler32(data, value), where data is a string or an
+// ArrayBufferView.
+template <uLong (*Checksum)(uLong, const Bytef*, uInt)>
+void ComputeChecksum(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsString() || args[0]->IsArrayBufferView());
+  CHECK(args[1]->IsUint32());
+  uint32_t value = args[1].As<Uint32>()->Value();
+
+  if (args[0]->IsString()) {
+    Utf8Value data(args.GetIsolate(), args[0]);
+    value = UpdateChecksum<Checksum>(value, *data, data.length());
+  } else {
+    ArrayBufferViewContents<char> data(args[0]);
+    value = UpdateChecksum<Checksum>(value, data.data(), data.length());
+  }
+
+  args.GetReturnValue().Set(value);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
                 void* priv) {
   Environment* env = Environment::GetCurrent(context);
+  BindingData* const binding_data =
+      env->AddBindingData<BindingData>(context, target);
+  if (binding_data == nullptr) return;
+
+  // By zlib convention, these calls detect the CPU features that select the
+  // SIMD implementations of the checksums.
+  crc32(0, Z_NULL, 0);
+  adler32(0, Z_NULL, 0);
+  env->SetMethodNoSideEffect(target, "crc32", ComputeChecksum<crc32>);
+  env->SetMethodNoSideEffect(target, "adler32", ComputeChecksum<adler32>);
 
   MakeClass<ZlibStream>::Make(env, target, "Zlib");
   MakeClass<BrotliEncoderStream>::Make(env, target, "BrotliEncoder");
   MakeClass<BrotliDecoderStream>::Make(env, target, "BrotliDecoder");
+  MakeOneShotJobClass<ZlibOneShotJob>(env, target, "ZlibOneShotJob");
+  MakeOneShotJobClass<BrotliOneShotJob>(env, target, "BrotliOneShotJob");
+  MakeClass<ZstdCompressStream>::Make(env, target, "ZstdCompress");
+  MakeClass<ZstdDecompressStream>::Make(env, target, "ZstdDecompress");
+  MakeOneShotJobClass<ZstdOneShotJob>(env, target, "ZstdOneShotJob");
+
+  Local<FunctionTemplate> parallel_deflate =
+      env->NewFunctionTemplate(ParallelDeflateJob::New);
+  parallel_deflate->InstanceTemplate()->SetInternalFieldCount(
+      ParallelDeflateJob::kInternalFieldCount);
+  parallel_deflate->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(parallel_deflate, "run", ParallelDeflateJob::Run);
+  Local<String> parallel_deflate_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "ParallelDeflateJob");
+  parallel_deflate->SetClassName(parallel_deflate_string);
+  target->Set(env->context(),
+              parallel_deflate_string,
+              parallel_deflate->GetFunction(env->context()).ToLocalChecked())
+      .Check();
 
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
@@ -1295,6 +2713,8 @@ void DefineZlibConstants(Local<Object> target) {
   NODE_DEFINE_CONSTANT(target, UNZIP);
   NODE_DEFINE_CONSTANT(target, BROTLI_DECODE);
   NODE_DEFINE_CONSTANT(target, BROTLI_ENCODE);
+  NODE_DEFINE_CONSTANT(target, ZSTD_COMPRESS);
+  NODE_DEFINE_CONSTANT(target, ZSTD_DECOMPRESS);
 
   NODE_DEFINE_CONSTANT(target, Z_MIN_WINDOWBITS);
   NODE_DEFINE_CONSTANT(target, Z_MAX_WINDOWBITS);
@@ -1374,6 +2794,38 @@ void DefineZlibConstants(Local<Object> target) {
   NODE_DEFINE_CONSTANT(target, BROTLI_DECODER_ERROR_ALLOC_RING_BUFFER_2);
   NODE_DEFINE_CONSTANT(target, BROTLI_DECODER_ERROR_ALLOC_BLOCK_TYPE_TREES);
   NODE_DEFINE_CONSTANT(target, BROTLI_DECODER_ERROR_UNREACHABLE);
+
+  // zstd-specific constants.
+  NODE_DEFINE_CONSTANT(target, ZSTD_e_continue);
+  NODE_DEFINE_CONSTANT(target, ZSTD_e_flush);
+  NODE_DEFINE_CONSTANT(target, ZSTD_e_end);
+  NODE_DEFINE_CONSTANT(target, ZSTD_fast);
+  NODE_DEFINE_CONSTANT(target, ZSTD_dfast);
+  NODE_DEFINE_CONSTANT(target, ZSTD_greedy);
+  NODE_DEFINE_CONSTANT(target, ZSTD_lazy);
+  NODE_DEFINE_CONSTANT(target, ZSTD_lazy2);
+  NODE_DEFINE_CONSTANT(target, ZSTD_btlazy2);
+  NODE_DEFINE_CONSTANT(target, ZSTD_btopt);
+  NODE_DEFINE_CONSTANT(target, ZSTD_btultra);
+  NODE_DEFINE_CONSTANT(target, ZSTD_btultra2);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_compressionLevel);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_windowLog);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_hashLog);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_chainLog);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_searchLog);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_minMatch);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_targetLength);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_strategy);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_enableLongDistanceMatching);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_ldmHashLog);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_ldmMinMatch);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_ldmBucketSizeLog);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_ldmHashRateLog);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_contentSizeFlag);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_checksumFlag);
+  NODE_DEFINE_CONSTANT(target, ZSTD_c_dictIDFlag);
+  NODE_DEFINE_CONSTANT(target, ZSTD_d_windowLogMax);
+  NODE_DEFINE_CONSTANT(target, ZSTD_CLEVEL_DEFAULT);
 }
 
 }  // namespace node
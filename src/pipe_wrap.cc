@@ -50,8 +50,16 @@ using v8::Value;
 MaybeLocal<Object> PipeWrap::Instantiate(Environment* env,
                                          AsyncWrap* parent,
                                          PipeWrap::SocketType type) {
+  CHECK_NOT_NULL(parent);
+  return Instantiate(env, parent->get_async_id(), type);
+}
+
+
+MaybeLocal<Object> PipeWrap::Instantiate(Environment* env,
+                                         double trigger_async_id,
+                                         PipeWrap::SocketType type) {
   EscapableHandleScope handle_scope(env->isolate());
-  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(parent);
+  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(env, trigger_async_id);
   CHECK_EQ(false, env->pipe_constructor_template().IsEmpty());
   Local<Function> constructor = env->pipe_constructor_template()
                                     ->GetFunction(env->context())
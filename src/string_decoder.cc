@@ -3,6 +3,7 @@
 
 #include "env-inl.h"
 #include "node_buffer.h"
+#include "node_errors.h"
 #include "string_bytes.h"
 #include "util.h"
 
@@ -14,8 +15,10 @@ using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Object;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 namespace node {
@@ -250,6 +253,153 @@ MaybeLocal<String> StringDecoder::FlushData(Isolate* isolate) {
   return ret;
 }
 
+void Utf8Decoder::Reset() {
+  ResetSequence();
+  bom_seen_ = false;
+}
+
+void Utf8Decoder::ResetSequence() {
+  code_point_ = 0;
+  bytes_seen_ = 0;
+  bytes_needed_ = 0;
+  lower_boundary_ = 0x80;
+  upper_boundary_ = 0xBF;
+}
+
+MaybeLocal<String> Utf8Decoder::Decode(Isolate* isolate,
+                                       const uint8_t* data,
+                                       size_t length,
+                                       int flags,
+                                       bool* invalid) {
+  const bool fatal = flags & kFatal;
+  *invalid = false;
+
+  // Find the ASCII prefix of the chunk, a word at a time.
+  size_t ascii = 0;
+  if (bytes_needed_ == 0) {
+    while (ascii + sizeof(uint64_t) <= length) {
+      uint64_t word;
+      memcpy(&word, data + ascii, sizeof(word));
+      if (word & 0x8080808080808080ull)
+        break;
+      ascii += sizeof(word);
+    }
+    while (ascii < length && data[ascii] < 0x80)
+      ascii++;
+  }
+
+  // Nothing is pending and the chunk is pure ASCII, so it can be turned into
+  // a one-byte string as it is. This is the common case for JSON and text
+  // protocols.
+  if (ascii == length && bytes_needed_ == 0) {
+    if (length > 0)
+      bom_seen_ = true;
+    if (flags & kFlush)
+      Reset();
+    if (length > static_cast<size_t>(String::kMaxLength)) {
+      isolate->ThrowException(ERR_STRING_TOO_LONG(isolate));
+      return MaybeLocal<String>();
+    }
+    return String::NewFromOneByte(
+        isolate, data, NewStringType::kNormal, static_cast<int>(length));
+  }
+
+  // Every input byte produces at most one UTF-16 code unit, except that a
+  // sequence started in an earlier chunk or an unfinished sequence at the
+  // end of the stream can add one more.
+  MaybeStackBuffer<uint16_t> out(length + 2);
+  size_t n = 0;
+  for (; n < ascii; n++)
+    out[n] = data[n];
+
+  for (size_t i = ascii; i < length;) {
+    const uint8_t byte = data[i];
+    if (bytes_needed_ == 0) {
+      i++;
+      if (byte <= 0x7F) {
+        out[n++] = byte;
+        continue;
+      }
+      ResetSequence();
+      if (byte >= 0xC2 && byte <= 0xDF) {
+        bytes_needed_ = 1;
+        code_point_ = byte & 0x1F;
+      } else if (byte >= 0xE0 && byte <= 0xEF) {
+        if (byte == 0xE0) lower_boundary_ = 0xA0;
+        if (byte == 0xED) upper_boundary_ = 0x9F;
+        bytes_needed_ = 2;
+        code_point_ = byte & 0xF;
+      } else if (byte >= 0xF0 && byte <= 0xF4) {
+        if (byte == 0xF0) lower_boundary_ = 0x90;
+        if (byte == 0xF4) upper_boundary_ = 0x8F;
+        bytes_needed_ = 3;
+        code_point_ = byte & 0x7;
+      } else {
+        if (fatal) goto invalid_input;
+        out[n++] = 0xFFFD;
+      }
+      continue;
+    }
+
+    if (byte < lower_boundary_ || byte > upper_boundary_) {
+      // The sequence ends here and the byte is processed again as the start
+      // of a new one.
+      ResetSequence();
+      if (fatal) goto invalid_input;
+      out[n++] = 0xFFFD;
+      continue;
+    }
+
+    i++;
+    lower_boundary_ = 0x80;
+    upper_boundary_ = 0xBF;
+    code_point_ = (code_point_ << 6) | (byte & 0x3F);
+    if (++bytes_seen_ < bytes_needed_)
+      continue;
+
+    if (code_point_ > 0xFFFF) {
+      out[n++] = 0xD800 + ((code_point_ - 0x10000) >> 10);
+      out[n++] = 0xDC00 + (code_point_ & 0x3FF);
+    } else {
+      out[n++] = code_point_;
+    }
+    ResetSequence();
+  }
+
+  if (flags & kFlush) {
+    if (bytes_needed_ != 0) {
+      if (fatal) goto invalid_input;
+      out[n++] = 0xFFFD;
+    }
+  }
+  CHECK_LE(n, out.length());
+
+  {
+    size_t start = 0;
+    if (n > 0 && !bom_seen_) {
+      if (!(flags & kIgnoreBOM) && out[0] == 0xFEFF)
+        start = 1;
+      bom_seen_ = true;
+    }
+    if (flags & kFlush)
+      Reset();
+
+    if (n - start > static_cast<size_t>(String::kMaxLength)) {
+      isolate->ThrowException(ERR_STRING_TOO_LONG(isolate));
+      return MaybeLocal<String>();
+    }
+    return String::NewFromTwoByte(isolate,
+                                  out.out() + start,
+                                  NewStringType::kNormal,
+                                  static_cast<int>(n - start));
+  }
+
+invalid_input:
+  Reset();
+  *invalid = true;
+  return MaybeLocal<String>();
+}
+
 namespace {
 
 void DecodeData(const FunctionCallbackInfo<Value>& args) {
@@ -267,6 +417,47 @@ void DecodeData(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(ret.ToLocalChecked());
 }
 
+// Decodes an array of chunks as if they were passed to DecodeData() one
+// after another. Character boundaries inside the joined data are found the
+// same way as at chunk boundaries, so decoding the joined bytes once yields
+// the same string without creating and concatenating one string per chunk.
+void DecodeDataArray(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  StringDecoder* decoder =
+      reinterpret_cast<StringDecoder*>(Buffer::Data(args[0]));
+  CHECK_NOT_NULL(decoder);
+
+  CHECK(args[1]->IsArray());
+  Local<Array> chunks = args[1].As<Array>();
+  const uint32_t count = chunks->Length();
+
+  size_t total = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> chunk;
+    if (!chunks->Get(context, i).ToLocal(&chunk))
+      return;
+    CHECK(chunk->IsArrayBufferView());
+    total += chunk.As<ArrayBufferView>()->ByteLength();
+  }
+
+  MaybeStackBuffer<char> joined(total);
+  size_t offset = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> chunk;
+    if (!chunks->Get(context, i).ToLocal(&chunk))
+      return;
+    Local<ArrayBufferView> view = chunk.As<ArrayBufferView>();
+    CHECK_LE(offset + view->ByteLength(), total);
+    offset += view->CopyContents(joined.out() + offset, view->ByteLength());
+  }
+
+  MaybeLocal<String> ret =
+      decoder->DecodeData(isolate, joined.out(), &offset);
+  if (!ret.IsEmpty())
+    args.GetReturnValue().Set(ret.ToLocalChecked());
+}
+
 void FlushData(const FunctionCallbackInfo<Value>& args) {
   StringDecoder* decoder =
       reinterpret_cast<StringDecoder*>(Buffer::Data(args[0]));
@@ -276,6 +467,25 @@ void FlushData(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(ret.ToLocalChecked());
 }
 
+void DecodeUTF8(const FunctionCallbackInfo<Value>& args) {
+  Utf8Decoder* decoder =
+      reinterpret_cast<Utf8Decoder*>(Buffer::Data(args[0]));
+  CHECK_NOT_NULL(decoder);
+
+  CHECK(args[1]->IsArrayBufferView());
+  CHECK(args[2]->IsUint32());
+  ArrayBufferViewContents<uint8_t> content(args[1].As<ArrayBufferView>());
+  const int flags = args[2].As<Uint32>()->Value();
+
+  bool invalid;
+  MaybeLocal<String> ret = decoder->Decode(
+      args.GetIsolate(), content.data(), content.length(), flags, &invalid);
+  // An invalid input in fatal mode leaves the return value undefined so that
+  // JS land can throw the appropriate error.
+  if (!ret.IsEmpty())
+    args.GetReturnValue().Set(ret.ToLocalChecked());
+}
+
 void InitializeStringDecoder(Local<Object> target,
                              Local<Value> unused,
                              Local<Context> context,
@@ -316,8 +526,14 @@ void InitializeStringDecoder(Local<Object> target,
               FIXED_ONE_BYTE_STRING(isolate, "kSize"),
               Integer::New(isolate, sizeof(StringDecoder))).Check();
 
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "kUTF8DecoderSize"),
+              Integer::New(isolate, sizeof(Utf8Decoder))).Check();
+
   env->SetMethod(target, "decode", DecodeData);
+  env->SetMethod(target, "decodeArray", DecodeDataArray);
   env->SetMethod(target, "flush", FlushData);
+  env->SetMethod(target, "decodeUTF8", DecodeUTF8);
 }
 
 }  // anonymous namespace
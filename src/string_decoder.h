@@ -43,6 +43,38 @@ class StringDecoder {
   uint8_t state_[kNumFields] = {};
 };
 
+// Streaming UTF-8 decoder implementing the WHATWG Encoding Standard, used by
+// TextDecoder. Like StringDecoder, the state lives in memory that is owned by
+// a JS Uint8Array; all-zero memory is a valid initial state.
+class Utf8Decoder {
+ public:
+  // These match the CONVERTER_FLAGS_* values in lib/internal/encoding.js.
+  enum Flags {
+    kFlush = 0x1,
+    kFatal = 0x2,
+    kIgnoreBOM = 0x4
+  };
+
+  // Decode a chunk of UTF-8. If `kFatal` is set and the input is invalid,
+  // an empty handle is returned without throwing and `*invalid` is set.
+  v8::MaybeLocal<v8::String> Decode(v8::Isolate* isolate,
+                                    const uint8_t* data,
+                                    size_t length,
+                                    int flags,
+                                    bool* invalid);
+
+ private:
+  inline void Reset();
+  inline void ResetSequence();
+
+  uint32_t code_point_;
+  uint8_t bytes_seen_;
+  uint8_t bytes_needed_;
+  uint8_t lower_boundary_;
+  uint8_t upper_boundary_;
+  bool bom_seen_;
+};
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -12,6 +12,23 @@
 #include <cstring>
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NODE_STRINGSEARCH_SSE2 1
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define NODE_STRINGSEARCH_AVX2 1
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NODE_STRINGSEARCH_NEON 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 namespace node {
 namespace stringsearch {
 
@@ -574,6 +591,192 @@ size_t StringSearch<Char>::InitialSearch(
   return subject.length();
 }
 
+//---------------------------------------------------------------------
+// Vectorized first/last byte filter
+//---------------------------------------------------------------------
+
+// For one-byte forward searches in long subjects, compare the first and the
+// last byte of the pattern against 16 or 32 subject positions at once and
+// only verify the positions where both match. This is much faster than
+// memchr() on the first byte when that byte is common (e.g. spaces or
+// newlines in log lines). When too many candidates turn out to be false
+// positives the filter gives up and the regular search continues, so the
+// worst case stays that of Boyer-Moore-Horspool.
+
+// Subjects shorter than this are not worth setting up the vectors for.
+static const size_t kFirstLastMinSubjectLength = 64;
+
+// `value` must not be zero.
+inline unsigned CountTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;  // NOLINT(runtime/int)
+#if defined(_M_X64) || defined(_M_ARM64)
+  _BitScanForward64(&index, value);
+  return static_cast<unsigned>(index);
+#else
+  // 32-bit targets only have the 32-bit intrinsic.
+  if (_BitScanForward(&index, static_cast<uint32_t>(value)))
+    return static_cast<unsigned>(index);
+  _BitScanForward(&index, static_cast<uint32_t>(value >> 32));
+  return static_cast<unsigned>(index) + 32;
+#endif
+#else
+  return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+// Verifies the candidates in `mask`, which has `bits_per_byte` bits set for
+// every subject position following `base` where the first and the last byte
+// of the pattern matched. Returns true if a match was found or the filter
+// should give up; `*index` is then the match or the position to resume from.
+inline bool CheckFirstLastCandidates(uint64_t mask,
+                                     unsigned bits_per_byte,
+                                     const uint8_t* subject,
+                                     size_t base,
+                                     const uint8_t* pattern,
+                                     size_t pattern_length,
+                                     int64_t* badness,
+                                     size_t* index,
+                                     bool* found) {
+  while (mask != 0) {
+    const size_t pos = base + CountTrailingZeros(mask) / bits_per_byte;
+    if (memcmp(subject + pos + 1, pattern + 1, pattern_length - 2) == 0) {
+      *index = pos;
+      *found = true;
+      return true;
+    }
+    if (++*badness > 0) {
+      *index = pos + 1;
+      return true;
+    }
+    mask &= mask - 1;
+  }
+  return false;
+}
+
+#if defined(NODE_STRINGSEARCH_AVX2)
+inline bool CPUHasAVX2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+__attribute__((target("avx2")))
+inline bool FirstLastSearchAVX2(const uint8_t* subject,
+                                size_t subject_length,
+                                const uint8_t* pattern,
+                                size_t pattern_length,
+                                size_t* index) {
+  const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+  const __m256i last =
+      _mm256_set1_epi8(static_cast<char>(pattern[pattern_length - 1]));
+  int64_t badness = -32;
+  bool found = false;
+  size_t i = *index;
+  for (; i + pattern_length + 31 <= subject_length; i += 32) {
+    const __m256i block_first =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(subject + i));
+    const __m256i block_last = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(subject + i + pattern_length - 1));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                         _mm256_cmpeq_epi8(block_last, last))));
+    if (CheckFirstLastCandidates(mask, 1, subject, i, pattern, pattern_length,
+                                 &badness, index, &found)) {
+      return found;
+    }
+    badness--;
+  }
+  *index = i;
+  return false;
+}
+#endif  // defined(NODE_STRINGSEARCH_AVX2)
+
+#if defined(NODE_STRINGSEARCH_SSE2)
+inline bool FirstLastSearchSSE2(const uint8_t* subject,
+                                size_t subject_length,
+                                const uint8_t* pattern,
+                                size_t pattern_length,
+                                size_t* index) {
+  const __m128i first = _mm_set1_epi8(static_cast<char>(pattern[0]));
+  const __m128i last =
+      _mm_set1_epi8(static_cast<char>(pattern[pattern_length - 1]));
+  int64_t badness = -32;
+  bool found = false;
+  size_t i = *index;
+  for (; i + pattern_length + 15 <= subject_length; i += 16) {
+    const __m128i block_first =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(subject + i));
+    const __m128i block_last = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(subject + i + pattern_length - 1));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(block_first, first),
+                      _mm_cmpeq_epi8(block_last, last))));
+    if (CheckFirstLastCandidates(mask, 1, subject, i, pattern, pattern_length,
+                                 &badness, index, &found)) {
+      return found;
+    }
+    badness--;
+  }
+  *index = i;
+  return false;
+}
+#elif defined(NODE_STRINGSEARCH_NEON)
+inline bool FirstLastSearchNEON(const uint8_t* subject,
+                                size_t subject_length,
+                                const uint8_t* pattern,
+                                size_t pattern_length,
+                                size_t* index) {
+  const uint8x16_t first = vdupq_n_u8(pattern[0]);
+  const uint8x16_t last = vdupq_n_u8(pattern[pattern_length - 1]);
+  int64_t badness = -32;
+  bool found = false;
+  size_t i = *index;
+  for (; i + pattern_length + 15 <= subject_length; i += 16) {
+    const uint8x16_t eq =
+        vandq_u8(vceqq_u8(vld1q_u8(subject + i), first),
+                 vceqq_u8(vld1q_u8(subject + i + pattern_length - 1), last));
+    // Narrow the comparison result to four bits per byte; NEON has no
+    // movemask instruction.
+    const uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0) &
+        0x8888888888888888ull;
+    if (CheckFirstLastCandidates(mask, 4, subject, i, pattern, pattern_length,
+                                 &badness, index, &found)) {
+      return found;
+    }
+    badness--;
+  }
+  *index = i;
+  return false;
+}
+#endif  // defined(NODE_STRINGSEARCH_SSE2)
+
+// Searches forward for a one-byte `pattern` of at least two bytes starting at
+// `*index`. Returns true if a match was found, in which case `*index` is its
+// position. Otherwise, the regular search has to continue from `*index`.
+inline bool FirstLastSearch(const uint8_t* subject,
+                            size_t subject_length,
+                            const uint8_t* pattern,
+                            size_t pattern_length,
+                            size_t* index) {
+  DCHECK_GE(pattern_length, 2);
+#if defined(NODE_STRINGSEARCH_AVX2)
+  if (CPUHasAVX2()) {
+    return FirstLastSearchAVX2(
+        subject, subject_length, pattern, pattern_length, index);
+  }
+#endif
+#if defined(NODE_STRINGSEARCH_SSE2)
+  return FirstLastSearchSSE2(
+      subject, subject_length, pattern, pattern_length, index);
+#elif defined(NODE_STRINGSEARCH_NEON)
+  return FirstLastSearchNEON(
+      subject, subject_length, pattern, pattern_length, index);
+#else
+  return false;
+#endif
+}
+
 // Perform a single stand-alone search.
 // If searching multiple times for the same pattern, a search
 // object should be constructed once and the Search function then called
@@ -598,6 +801,17 @@ size_t SearchString(const Char* haystack,
                     size_t start_index,
                     bool is_forward) {
   if (haystack_length < needle_length) return haystack_length;
+  if (sizeof(Char) == 1 && is_forward && needle_length >= 2 &&
+      start_index + stringsearch::kFirstLastMinSubjectLength <=
+          haystack_length) {
+    if (stringsearch::FirstLastSearch(
+            reinterpret_cast<const uint8_t*>(haystack), haystack_length,
+            reinterpret_cast<const uint8_t*>(needle), needle_length,
+            &start_index)) {
+      return start_index;
+    }
+    if (start_index > haystack_length - needle_length) return haystack_length;
+  }
   // To do a reverse search (lastIndexOf instead of indexOf) without redundant
   // code, create two vectors that are reversed views into the input strings.
   // For example, v_needle[0] would return the *last* character of the needle.
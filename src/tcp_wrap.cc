@@ -54,8 +54,16 @@ using v8::Value;
 MaybeLocal<Object> TCPWrap::Instantiate(Environment* env,
                                         AsyncWrap* parent,
                                         TCPWrap::SocketType type) {
+  CHECK_NOT_NULL(parent);
+  return Instantiate(env, parent->get_async_id(), type);
+}
+
+
+MaybeLocal<Object> TCPWrap::Instantiate(Environment* env,
+                                        double trigger_async_id,
+                                        TCPWrap::SocketType type) {
   EscapableHandleScope handle_scope(env->isolate());
-  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(parent);
+  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(env, trigger_async_id);
   CHECK_EQ(env->tcp_constructor_template().IsEmpty(), false);
   Local<Function> constructor = env->tcp_constructor_template()
                                     ->GetFunction(env->context())
@@ -41,6 +41,11 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
   static v8::MaybeLocal<v8::Object> Instantiate(Environment* env,
                                                 AsyncWrap* parent,
                                                 SocketType type);
+  // Used when there is no parent wrap, e.g. for handles received from
+  // another thread.
+  static v8::MaybeLocal<v8::Object> Instantiate(Environment* env,
+                                                double trigger_async_id,
+                                                SocketType type);
   static void Initialize(v8::Local<v8::Object> target,
                          v8::Local<v8::Value> unused,
                          v8::Local<v8::Context> context,
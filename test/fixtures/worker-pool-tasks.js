@@ -0,0 +1,17 @@
+'use strict';
+
+module.exports = (value) => value * 2;
+
+module.exports.echo = (value) => value;
+
+module.exports.byteLength = (buffer) => buffer.byteLength;
+
+module.exports.fail = (message) => {
+  throw new Error(message);
+};
+
+module.exports.wait = (ms) => {
+  return new Promise((resolve) => setTimeout(resolve, ms, ms));
+};
+
+module.exports.exit = (code) => process.exit(code);
@@ -0,0 +1,54 @@
+// Flags: --experimental-arraybuffer-arena
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+// Buffers of all sizes keep their contents and are zero-filled where
+// expected.
+const sizes = [0, 1, 15, 16, 17, 4095, 4096, 8191, 8192, 8193, 65536];
+const buffers = [];
+for (const size of sizes) {
+  const zeroed = Buffer.alloc(size);
+  assert(zeroed.every((byte) => byte === 0));
+  const buffer = Buffer.allocUnsafeSlow(size).fill(size & 0xff);
+  buffers.push(buffer);
+  assert.strictEqual(new ArrayBuffer(size).byteLength, size);
+}
+for (let i = 0; i < sizes.length; i++) {
+  assert.strictEqual(buffers[i].length, sizes[i]);
+  assert(buffers[i].every((byte) => byte === (sizes[i] & 0xff)));
+}
+
+// Allocated memory is still accounted for per thread.
+{
+  const before = process.memoryUsage().arrayBuffers;
+  const keep = [];
+  for (let i = 0; i < 100; i++)
+    keep.push(Buffer.allocUnsafeSlow(1000));
+  assert(process.memoryUsage().arrayBuffers >= before + 100 * 1000);
+}
+
+// Memory allocated on one thread can be transferred to and released by
+// another.
+const worker = new Worker(`
+const { parentPort } = require('worker_threads');
+parentPort.on('message', (ab) => {
+  const view = new Uint8Array(ab);
+  view.fill(view.length & 0xff);
+  const copy = new ArrayBuffer(view.length);
+  parentPort.postMessage(copy, [copy]);
+  parentPort.postMessage(ab, [ab]);
+});
+`, { eval: true });
+
+let received = 0;
+worker.on('message', common.mustCall((ab) => {
+  if (++received === 2 * sizes.length)
+    worker.terminate();
+}, 2 * sizes.length));
+for (const size of sizes) {
+  const ab = new ArrayBuffer(size);
+  worker.postMessage(ab, [ab]);
+  assert.strictEqual(ab.byteLength, 0);
+}
@@ -0,0 +1,51 @@
+'use strict';
+
+// Buffer.concat() hands long lists to a single native copy. Check that it
+// behaves exactly like the JavaScript path it replaces.
+
+require('../common');
+const assert = require('assert');
+
+const chunks = [];
+for (let i = 0; i < 100; i++)
+  chunks.push(Buffer.from([i, i + 1, i + 2]));
+const expected = Buffer.from(chunks.flatMap((c) => [...c]));
+
+assert.deepStrictEqual(Buffer.concat(chunks), expected);
+assert.deepStrictEqual(Buffer.concat(chunks, expected.length), expected);
+
+// A shorter totalLength truncates the result.
+assert.deepStrictEqual(Buffer.concat(chunks, 31), expected.slice(0, 31));
+
+// A longer totalLength zero-fills the remainder.
+{
+  const result = Buffer.concat(chunks, expected.length + 10);
+  assert.deepStrictEqual(result.slice(0, expected.length), expected);
+  assert.deepStrictEqual(result.slice(expected.length), Buffer.alloc(10));
+}
+
+// Plain Uint8Arrays, including views into larger buffers, are accepted.
+{
+  const backing = new Uint8Array(64).map((_, i) => i);
+  const views = [];
+  for (let i = 0; i < 16; i++)
+    views.push(new Uint8Array(backing.buffer, i * 4, 4));
+  assert.deepStrictEqual(Buffer.concat(views), Buffer.from(backing));
+}
+
+// Empty chunks are skipped.
+{
+  const list = new Array(20).fill(Buffer.alloc(0));
+  list[10] = Buffer.from('abc');
+  assert.strictEqual(Buffer.concat(list).toString(), 'abc');
+}
+
+// The error names the first invalid element.
+{
+  const list = new Array(20).fill(Buffer.from('x'));
+  list[13] = 'not a buffer';
+  assert.throws(() => Buffer.concat(list), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: /"list\[13\]"/
+  });
+}
@@ -0,0 +1,49 @@
+'use strict';
+
+// Hex encoding and decoding work on blocks of 16 bytes. Check lengths and
+// invalid digits around the block boundaries against a plain implementation.
+
+require('../common');
+const assert = require('assert');
+
+function toHex(buf) {
+  let out = '';
+  for (const byte of buf)
+    out += (byte < 16 ? '0' : '') + byte.toString(16);
+  return out;
+}
+
+for (let len = 0; len <= 100; len++) {
+  const buf = Buffer.alloc(len);
+  for (let i = 0; i < len; i++)
+    buf[i] = (i * 37 + len) & 0xff;
+  const hex = toHex(buf);
+  assert.strictEqual(buf.toString('hex'), hex);
+  assert.deepStrictEqual(Buffer.from(hex, 'hex'), buf);
+  assert.deepStrictEqual(Buffer.from(hex.toUpperCase(), 'hex'), buf);
+  // Two-byte strings take a different path through the decoder.
+  assert.deepStrictEqual(Buffer.from(`${hex}Ā`, 'hex'), buf);
+}
+
+// Decoding stops at the first byte that contains an invalid digit.
+{
+  const buf = Buffer.alloc(48, 0xab);
+  const hex = buf.toString('hex');
+  for (const bad of ['g', 'G', '/', ':', '@', '`', ' ', 'Á']) {
+    for (let pos = 0; pos < hex.length; pos++) {
+      const str = hex.slice(0, pos) + bad + hex.slice(pos + 1);
+      assert.deepStrictEqual(Buffer.from(str, 'hex'),
+                             buf.slice(0, pos >> 1));
+    }
+  }
+}
+
+// Partial writes into a target that is shorter than the input.
+{
+  const hex = Buffer.alloc(64, 0x5a).toString('hex');
+  for (let size = 0; size <= 40; size++) {
+    const target = Buffer.alloc(size);
+    assert.strictEqual(target.write(hex, 'hex'), size);
+    assert.deepStrictEqual(target, Buffer.alloc(size, 0x5a));
+  }
+}
@@ -0,0 +1,47 @@
+'use strict';
+
+// Forward searches in long buffers filter candidates by the first and last
+// byte of the needle in blocks. Compare against String#indexOf() on inputs
+// with many false candidates.
+
+require('../common');
+const assert = require('assert');
+
+const alphabet = 'ab';
+let seed = 1;
+function random(n) {
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return seed % n;
+}
+
+for (let round = 0; round < 300; round++) {
+  let haystack = '';
+  const haystackLength = 64 + random(400);
+  for (let i = 0; i < haystackLength; i++)
+    haystack += alphabet[random(alphabet.length)];
+  let needle = '';
+  const needleLength = 2 + random(12);
+  for (let i = 0; i < needleLength; i++)
+    needle += alphabet[random(alphabet.length)];
+
+  const buf = Buffer.from(haystack, 'latin1');
+  for (const offset of [0, 1, 15, 16, 17, 31, 32, 33, random(haystackLength)]) {
+    assert.strictEqual(buf.indexOf(needle, offset, 'latin1'),
+                       haystack.indexOf(needle, offset),
+                       `${needle} in ${haystack} from ${offset}`);
+    assert.strictEqual(buf.indexOf(Buffer.from(needle), offset),
+                       haystack.indexOf(needle, offset));
+  }
+}
+
+// A match in the last bytes, after a long run of near misses.
+{
+  const buf = Buffer.alloc(100000, ' ');
+  for (let i = 0; i < buf.length; i += 80)
+    buf[i] = 0x0a;
+  buf.write(' ERROR', buf.length - 6);
+  assert.strictEqual(buf.indexOf(' ERROR'), buf.length - 6);
+  assert.strictEqual(buf.includes(' ERRORS'), false);
+  assert.strictEqual(buf.indexOf('  '), 1);
+  assert.strictEqual(buf.indexOf(' \n '), 79);
+}
@@ -0,0 +1,65 @@
+// Flags: --expose-gc
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel } = require('worker_threads');
+
+const big = Buffer.alloc(64 * 1024);
+for (let i = 0; i < big.length; i++)
+  big[i] = 0x20 + (i % 95);
+const small = Buffer.from('small buffer');
+
+for (const buf of [big, small]) {
+  for (const encoding of [undefined, 'latin1', 'binary', 'ascii', 'utf8']) {
+    assert.strictEqual(buf.toExternalString(encoding),
+                       buf.toString(encoding));
+    assert.strictEqual(buf.toExternalString(encoding, 3),
+                       buf.toString(encoding, 3));
+    assert.strictEqual(buf.toExternalString(encoding, 1, buf.length - 1),
+                       buf.toString(encoding, 1, buf.length - 1));
+  }
+  assert.strictEqual(buf.toExternalString('latin1', 5, 5), '');
+  assert.strictEqual(buf.toExternalString('latin1', buf.length + 1), '');
+}
+
+// Non-ASCII bytes are never shared for ASCII and UTF-8, so these decode
+// exactly like toString().
+{
+  const buf = Buffer.alloc(64 * 1024, 'añb€');
+  for (const encoding of ['latin1', 'ascii', 'utf8'])
+    assert.strictEqual(buf.toExternalString(encoding), buf.toString(encoding));
+}
+
+// Views into a larger ArrayBuffer use the right offset.
+{
+  const ab = new ArrayBuffer(100 * 1024);
+  const bytes = new Uint8Array(ab);
+  for (let i = 0; i < bytes.length; i++)
+    bytes[i] = 0x61 + (i % 26);
+  const view = Buffer.from(ab, 1000, 80 * 1024);
+  assert.strictEqual(view.toExternalString('latin1'), view.toString('latin1'));
+}
+
+assert.throws(() => big.toExternalString('hex'), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+assert.throws(() => big.toExternalString('nope'), {
+  code: 'ERR_UNKNOWN_ENCODING'
+});
+
+// The string keeps the memory alive after the buffer is gone, even if its
+// ArrayBuffer has been transferred away.
+{
+  const ab = new ArrayBuffer(32 * 1024);
+  new Uint8Array(ab).fill(0x7a);
+  const str = Buffer.from(ab).toExternalString('latin1');
+  const { port1, port2 } = new MessageChannel();
+  port1.postMessage(ab, [ab]);
+  assert.strictEqual(ab.byteLength, 0);
+  port2.once('message', common.mustCall(() => {
+    port1.close();
+    global.gc();
+    assert.strictEqual(str, 'z'.repeat(32 * 1024));
+  }));
+}
@@ -0,0 +1,28 @@
+// Flags: --no-crypto-entropy-cache
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const crypto = require('crypto');
+
+// With the entropy cache disabled, synchronous calls never queue a
+// threadpool request to refill the cache.
+const hook = async_hooks.createHook({
+  init(id, type) {
+    assert.notStrictEqual(type, 'RANDOMBYTESREQUEST');
+  }
+}).enable();
+
+for (let i = 0; i < 1000; i++) {
+  const size = 1 + (i % 64);
+  const buf = crypto.randomBytes(size);
+  assert(Buffer.isBuffer(buf));
+  assert.strictEqual(buf.length, size);
+  assert.match(crypto.randomUUID(),
+               /^[0-9a-f]{8}-[0-9a-f]{4}-4[0-9a-f]{3}-[89ab][0-9a-f]{3}-[0-9a-f]{12}$/);
+}
+
+hook.disable();
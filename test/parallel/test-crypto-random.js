@@ -315,3 +315,23 @@ assert.throws(
   assert.strictEqual(desc.writable, true);
   assert.strictEqual(desc.enumerable, false);
 });
+
+{
+  // Small synchronous requests are served from the entropy cache that is
+  // shared with randomUUID(). Each call must get fresh bytes of its own.
+  const seen = new Set();
+  for (let i = 0; i < 1000; i++) {
+    const size = 1 + (i % 64);
+    const buf = crypto.randomBytes(size);
+    assert(Buffer.isBuffer(buf));
+    assert.strictEqual(buf.length, size);
+    assert.strictEqual(buf.buffer.byteLength, size);
+    if (size >= 16) {
+      const hex = buf.toString('hex', 0, 16);
+      assert(!seen.has(hex));
+      seen.add(hex);
+    }
+    if (i % 7 === 0)
+      crypto.randomUUID();
+  }
+}
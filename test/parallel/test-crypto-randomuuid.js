@@ -0,0 +1,69 @@
+'use strict';
+
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const {
+  randomUUID,
+} = require('crypto');
+
+const last = new Set([
+  '00000000-0000-0000-0000-000000000000'
+]);
+
+function testMatch(uuid) {
+  assert.match(
+    uuid,
+    /^[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$/);
+}
+
+// Generate a number of UUID's to make sure we're
+// not just generating the same value over and over
+// and to make sure the batching changes the random
+// bytes, including across the asynchronous refill.
+for (let n = 0; n < 300; n++) {
+  const value = randomUUID();
+  assert(!last.has(value));
+  last.add(value);
+  assert.strictEqual(typeof value, 'string');
+  assert.strictEqual(value.length, 36);
+  testMatch(value);
+
+  // Check that version 4 identifier was populated.
+  assert.strictEqual(
+    Buffer.from(value.substr(14, 2), 'hex')[0] & 0x40, 0x40);
+
+  // Check that clock_seq_hi_and_reserved was populated with reserved bits.
+  assert.strictEqual(
+    Buffer.from(value.substr(19, 2), 'hex')[0] & 0b1100_0000, 0b1000_0000);
+}
+
+// Test non-buffered UUID's
+{
+  testMatch(randomUUID({ disableEntropyCache: true }));
+  testMatch(randomUUID({ disableEntropyCache: true }));
+  testMatch(randomUUID({ disableEntropyCache: true }));
+  testMatch(randomUUID({ disableEntropyCache: true }));
+
+  assert.throws(() => randomUUID(1), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+
+  assert.throws(() => randomUUID({ disableEntropyCache: '' }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+
+// Once the asynchronous refill of the spare batch has completed, the
+// following batches must still yield unique values.
+setImmediate(common.mustCall(() => {
+  for (let n = 0; n < 300; n++) {
+    const value = randomUUID();
+    assert(!last.has(value));
+    last.add(value);
+    testMatch(value);
+  }
+}));
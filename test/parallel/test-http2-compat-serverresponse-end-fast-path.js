@@ -0,0 +1,74 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+// Ending a response with a body before the headers were sent must deliver
+// the body in full, only wait for trailers if some were set, and still
+// invoke the end() callback.
+
+const server = http2.createServer(common.mustCall((req, res) => {
+  const { stream } = res;
+  if (req.url === '/trailers') {
+    res.setTrailer('x-trailer', 'done');
+    stream.on('wantTrailers', common.mustCall());
+  } else {
+    stream.on('wantTrailers', common.mustNotCall());
+  }
+  res.setHeader('content-type', 'text/plain');
+  res.end('hello world', common.mustCall());
+}, 3));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  let pending = 3;
+  const done = () => {
+    if (--pending === 0) {
+      client.close();
+      server.close();
+    }
+  };
+
+  {
+    const req = client.request({ ':path': '/' });
+    let data = '';
+    req.setEncoding('utf8');
+    req.on('response', common.mustCall((headers) => {
+      assert.strictEqual(headers[':status'], 200);
+      assert.strictEqual(headers['content-type'], 'text/plain');
+    }));
+    req.on('trailers', common.mustNotCall());
+    req.on('data', (chunk) => data += chunk);
+    req.on('end', common.mustCall(() => {
+      assert.strictEqual(data, 'hello world');
+      done();
+    }));
+  }
+
+  {
+    const req = client.request({ ':path': '/trailers' });
+    let data = '';
+    req.setEncoding('utf8');
+    req.on('trailers', common.mustCall((trailers) => {
+      assert.strictEqual(trailers['x-trailer'], 'done');
+    }));
+    req.on('data', (chunk) => data += chunk);
+    req.on('end', common.mustCall(() => {
+      assert.strictEqual(data, 'hello world');
+      done();
+    }));
+  }
+
+  {
+    const req = client.request({ ':path': '/', ':method': 'HEAD' });
+    req.on('response', common.mustCall((headers) => {
+      assert.strictEqual(headers[':status'], 200);
+    }));
+    req.on('data', common.mustNotCall());
+    req.on('end', common.mustCall(done));
+    req.resume();
+  }
+}));
@@ -0,0 +1,45 @@
+'use strict';
+
+// Checks that header fields the peer encoded as never indexed are delivered
+// but not retained in the per-session header string cache.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+const net = require('net');
+const h2test = require('../common/http2');
+
+// :method GET, :scheme https and :path / from the static table, followed by
+// the literal field "x-secret: secret" encoded as never indexed.
+const kHeaders = Buffer.concat([
+  Buffer.from('828684', 'hex'),
+  Buffer.from([0x10, 8]), Buffer.from('x-secret'),
+  Buffer.from([6]), Buffer.from('secret')
+]);
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream, headers) => {
+  assert.strictEqual(headers['x-secret'], 'secret');
+  const { headerStringCacheHits, headerStringCacheMisses } =
+    stream.session.state;
+  assert.strictEqual(headerStringCacheHits, 0);
+  assert.strictEqual(headerStringCacheMisses, 0);
+  stream.respond();
+  stream.end();
+  stream.session.close();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const settings = new h2test.SettingsFrame();
+  const headers = new h2test.HeadersFrame(1, kHeaders, 0, true);
+  const client = net.connect(server.address().port, () => {
+    client.write(h2test.kClientMagic);
+    client.write(settings.data);
+    client.write(headers.data);
+  });
+  client.on('error', () => {});
+  client.on('close', common.mustCall(() => server.close()));
+  client.resume();
+}));
@@ -0,0 +1,51 @@
+'use strict';
+
+// Checks that header names and values which are repeated through the HPACK
+// dynamic table reuse the strings created for earlier requests, and that the
+// values are delivered correctly either way.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+const kRequests = 10;
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream, headers) => {
+  assert.strictEqual(headers['x-custom-name'], 'custom-value');
+  assert.strictEqual(headers['grpc-timeout'], `${headers['x-request']}S`);
+  stream.respond({ 'x-custom-response': 'response-value' });
+  stream.end();
+}, kRequests));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  let remaining = kRequests;
+
+  function request(n) {
+    const req = client.request({
+      ':path': '/service/method',
+      'x-custom-name': 'custom-value',
+      'x-request': `${n}`,
+      'grpc-timeout': `${n}S`
+    });
+    req.on('response', common.mustCall((headers) => {
+      assert.strictEqual(headers['x-custom-response'], 'response-value');
+    }));
+    req.resume();
+    req.on('end', common.mustCall(() => {
+      if (--remaining > 0)
+        return request(n + 1);
+
+      const { headerStringCacheHits, headerStringCacheMisses } = client.state;
+      assert(headerStringCacheMisses > 0);
+      assert(headerStringCacheHits > 0);
+      client.close();
+      server.close();
+    }));
+    req.end();
+  }
+  request(0);
+}));
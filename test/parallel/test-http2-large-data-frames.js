@@ -0,0 +1,50 @@
+'use strict';
+
+// Checks that large responses arrive intact when the peer allows DATA frames
+// larger than the default 16 KiB, including with padding enabled.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+const { PADDING_STRATEGY_MAX } = http2.constants;
+
+const body = Buffer.alloc(4 * 1024 * 1024);
+for (let i = 0; i < body.length; i++)
+  body[i] = i % 251;
+
+function test(maxFrameSize, paddingStrategy, cb) {
+  const settings = {
+    maxFrameSize,
+    initialWindowSize: 2 * 1024 * 1024,
+  };
+  const server = http2.createServer({ settings, paddingStrategy });
+  server.on('stream', common.mustCall((stream) => {
+    stream.respond();
+    // Write in chunks that do not line up with the frame size.
+    stream.write(body.slice(0, 100000));
+    stream.write(body.slice(100000, 3000000));
+    stream.end(body.slice(3000000));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = http2.connect(`http://localhost:${server.address().port}`,
+                                 { settings });
+    const req = client.request();
+    const chunks = [];
+    req.on('data', (chunk) => chunks.push(chunk));
+    req.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), body);
+      client.close();
+      server.close(cb);
+    }));
+    req.end();
+  }));
+}
+
+test(16384, undefined, common.mustCall(() => {
+  test(1024 * 1024, undefined, common.mustCall(() => {
+    test(1024 * 1024, PADDING_STRATEGY_MAX, common.mustCall());
+  }));
+}));
@@ -37,6 +37,11 @@ function onStream(stream, headers, flags) {
     assert.strictEqual(typeof state.outboundQueueSize, 'number');
     assert.strictEqual(typeof state.deflateDynamicTableSize, 'number');
     assert.strictEqual(typeof state.inflateDynamicTableSize, 'number');
+    assert.strictEqual(typeof state.headerStringCacheHits, 'number');
+    assert.strictEqual(typeof state.headerStringCacheMisses, 'number');
+    assert.strictEqual(typeof state.autotunedWindowSize, 'number');
+    assert.strictEqual(typeof state.bdpEstimate, 'number');
+    assert.strictEqual(typeof state.rtt, 'number');
   }
 
   stream.respond({
@@ -84,6 +89,11 @@ server.on('listening', common.mustCall(() => {
       assert.strictEqual(typeof state.outboundQueueSize, 'number');
       assert.strictEqual(typeof state.deflateDynamicTableSize, 'number');
       assert.strictEqual(typeof state.inflateDynamicTableSize, 'number');
+      assert.strictEqual(typeof state.headerStringCacheHits, 'number');
+      assert.strictEqual(typeof state.headerStringCacheMisses, 'number');
+      assert.strictEqual(typeof state.autotunedWindowSize, 'number');
+      assert.strictEqual(typeof state.bdpEstimate, 'number');
+      assert.strictEqual(typeof state.rtt, 'number');
     }
   }));
 
@@ -0,0 +1,78 @@
+'use strict';
+
+// Checks that flow control window autotuning does not interfere with data
+// transfer or with user PINGs, and that its statistics are reported through
+// session.state.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+const body = Buffer.alloc(4 * 1024 * 1024);
+for (let i = 0; i < body.length; i++)
+  body[i] = i % 253;
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream) => {
+  stream.respond();
+  stream.end(body);
+}, 2));
+
+for (const value of [-1, 1.5, 2 ** 31]) {
+  assert.throws(
+    () => http2.connect('http://localhost:1', { maxAutotunedWindowSize: value }),
+    { code: 'ERR_OUT_OF_RANGE' });
+}
+assert.throws(
+  () => http2.connect('http://localhost:1', { maxAutotunedWindowSize: '1' }),
+  { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(
+  () => http2.createServer({ maxAutotunedWindowSize: -1 }),
+  { code: 'ERR_OUT_OF_RANGE' });
+
+// A user PING with the payload of the internal BDP pings must still be
+// delivered to its callback.
+const bdpPayload = Buffer.from('nodebdp\0');
+
+function download(options, cb) {
+  const client = http2.connect(`http://localhost:${server.address().port}`,
+                               options);
+  client.on('ping', common.mustNotCall());
+  const req = client.request();
+  req.once('data', common.mustCall(() => {
+    assert(client.ping(bdpPayload, common.mustCall((err, duration, payload) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(payload, bdpPayload);
+    })));
+  }));
+  const chunks = [];
+  req.on('data', (chunk) => chunks.push(chunk));
+  req.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), body);
+    const state = client.state;
+    client.close();
+    cb(state);
+  }));
+  req.end();
+}
+
+server.listen(0, common.mustCall(() => {
+  download({}, common.mustCall((state) => {
+    assert.strictEqual(state.autotunedWindowSize, 0);
+    assert.strictEqual(state.bdpEstimate, 0);
+    assert.strictEqual(state.rtt, 0);
+
+    const maxAutotunedWindowSize = 1024 * 1024;
+    download({ maxAutotunedWindowSize }, common.mustCall((state) => {
+      // The window must have grown past the initial 65535 bytes but never
+      // beyond the configured maximum.
+      assert(state.autotunedWindowSize > 65535);
+      assert(state.autotunedWindowSize <= maxAutotunedWindowSize);
+      assert(state.bdpEstimate > 0);
+      assert(state.rtt > 0);
+      server.close();
+    }));
+  }));
+}));
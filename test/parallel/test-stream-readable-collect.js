@@ -0,0 +1,65 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { Readable } = require('stream');
+
+(async () => {
+  {
+    const chunks = [];
+    for (let i = 0; i < 50; i++)
+      chunks.push(Buffer.from(`chunk${i};`));
+    const result = await Readable.from(chunks, { objectMode: false }).collect();
+    assert(Buffer.isBuffer(result));
+    assert.deepStrictEqual(result, Buffer.concat(chunks));
+  }
+
+  {
+    const stream = new Readable({ read() {} });
+    stream.setEncoding('utf8');
+    stream.push(Buffer.from([0xe2, 0x82]));
+    stream.push(Buffer.from([0xac, 0x41]));
+    stream.push(null);
+    assert.strictEqual(await stream.collect(), '€A');
+  }
+
+  {
+    const result = await Readable.from([1, 'two', { three: 3 }]).collect();
+    assert.deepStrictEqual(result, [1, 'two', { three: 3 }]);
+  }
+
+  {
+    const stream = new Readable({ read() {} });
+    stream.push(null);
+    assert.deepStrictEqual(await stream.collect(), Buffer.alloc(0));
+  }
+
+  {
+    const stream = new Readable({ read() {} });
+    const promise = stream.collect();
+    stream.push('partial');
+    stream.destroy(new Error('boom'));
+    await assert.rejects(promise, { message: 'boom' });
+  }
+
+  {
+    const stream = new Readable({ read() {} });
+    const promise = stream.collect();
+    stream.destroy();
+    await assert.rejects(promise, { code: 'ERR_STREAM_PREMATURE_CLOSE' });
+  }
+
+  {
+    // A userland collect() shadows the prototype method but the original
+    // remains reachable through Readable.prototype.
+    class Collector extends Readable {
+      collect() { return 'userland'; }
+    }
+    const stream = new Collector({ read() {} });
+    stream.push('abc');
+    stream.push(null);
+    assert.strictEqual(stream.collect(), 'userland');
+    const result = await Readable.prototype.collect.call(stream);
+    assert.deepStrictEqual(result, Buffer.from('abc'));
+  }
+})().then(common.mustCall());
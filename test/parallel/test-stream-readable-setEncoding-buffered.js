@@ -0,0 +1,47 @@
+'use strict';
+
+// setEncoding() converts all chunks that are already buffered at once. The
+// result has to match decoding them one by one.
+
+require('../common');
+const assert = require('assert');
+const { Readable } = require('stream');
+const { StringDecoder } = require('string_decoder');
+
+const text = 'a€bé𝌆ÿ'.repeat(20);
+const bytes = Buffer.from(text);
+
+for (const encoding of ['utf8', 'utf16le', 'base64', 'hex', 'latin1']) {
+  for (const size of [1, 2, 3, 5, 7]) {
+    const chunks = [];
+    for (let i = 0; i < bytes.length; i += size)
+      chunks.push(bytes.slice(i, i + size));
+
+    const decoder = new StringDecoder(encoding);
+    const expected = chunks.map((chunk) => decoder.write(chunk)).join('') +
+                     decoder.end();
+
+    const readable = new Readable({ read() {} });
+    for (const chunk of chunks)
+      readable.push(chunk);
+    readable.setEncoding(encoding);
+    readable.push(null);
+
+    let result = '';
+    let chunk;
+    while ((chunk = readable.read()) !== null)
+      result += chunk;
+    assert.strictEqual(result, expected, `${encoding} with size ${size}`);
+  }
+}
+
+// Calling setEncoding() again keeps content that is already decoded.
+{
+  const readable = new Readable({ read() {} });
+  readable.push(Buffer.from([0xe2, 0x82]));
+  readable.setEncoding('utf8');
+  readable.push(Buffer.from([0xac, 0x41]));
+  readable.setEncoding('utf8');
+  readable.push(null);
+  assert.strictEqual(readable.read(), '€A');
+}
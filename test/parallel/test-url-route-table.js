@@ -0,0 +1,74 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const { RouteTable } = require('url');
+
+const table = new RouteTable([
+  '/',
+  '/users',
+  '/users/:id',
+  '/users/me',
+  '/users/:id/posts/:postId',
+  '/files/*',
+  '/users/:id/*',
+  '/a/:x/c',
+  '/a/b/d',
+]);
+
+function match(path) {
+  const result = table.match(path);
+  if (result === null)
+    return null;
+  assert.strictEqual(Object.getPrototypeOf(result.params), null);
+  return { id: result.id, params: { ...result.params } };
+}
+
+assert.deepStrictEqual(match('/'), { id: 0, params: {} });
+assert.deepStrictEqual(match('/users'), { id: 1, params: {} });
+assert.deepStrictEqual(match('/users/42'), { id: 2, params: { id: '42' } });
+// Literal segments are preferred over parameters, independent of the order.
+assert.deepStrictEqual(match('/users/me'), { id: 3, params: {} });
+assert.deepStrictEqual(match('/users/42/posts/7'),
+                       { id: 4, params: { id: '42', postId: '7' } });
+assert.deepStrictEqual(match('/users/me/posts/7'),
+                       { id: 4, params: { id: 'me', postId: '7' } });
+assert.deepStrictEqual(match('/files/'), { id: 5, params: { 0: '' } });
+assert.deepStrictEqual(match('/files/a/b.txt'),
+                       { id: 5, params: { 0: 'a/b.txt' } });
+assert.deepStrictEqual(match('/users/42/x/y'),
+                       { id: 6, params: { id: '42', 0: 'x/y' } });
+// Matching backtracks if a literal segment leads to a dead end.
+assert.deepStrictEqual(match('/a/b/c'), { id: 7, params: { x: 'b' } });
+assert.deepStrictEqual(match('/a/b/d'), { id: 8, params: {} });
+
+// The query and the fragment are ignored, and values are not decoded.
+assert.deepStrictEqual(match('/users/j%C3%B6rg?x=/y#z'),
+                       { id: 2, params: { id: 'j%C3%B6rg' } });
+assert.deepStrictEqual(match('/users/jörg'), { id: 2, params: { id: 'jörg' } });
+
+for (const path of ['', 'users', '/users/', '/files', '/nope',
+                    '/users//posts/1', '?/users', '/a/b']) {
+  assert.strictEqual(table.match(path), null, path);
+}
+
+assert.strictEqual(new RouteTable([]).match('/'), null);
+
+assert.throws(() => new RouteTable('/'), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => new RouteTable([1]), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => table.match(), { code: 'ERR_INVALID_ARG_TYPE' });
+
+for (const pattern of ['users', '/users?x', '/a#b', '/*/a', '/:', '/:1',
+                       '/:a-b', '/:id/:id']) {
+  assert.throws(() => new RouteTable([pattern]), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  }, pattern);
+}
+
+assert.throws(() => new RouteTable(['/users/:id', '/users/:name']), {
+  code: 'ERR_INVALID_ARG_VALUE',
+  message: "The argument 'patterns[1]' is equivalent to an earlier pattern. " +
+           "Received '/users/:name'"
+});
+assert.throws(() => new RouteTable(['/files/*', '/files/*']), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
@@ -0,0 +1,91 @@
+'use strict';
+
+// UTF-8 is decoded natively regardless of whether ICU is available. This
+// covers the streaming state, fatal mode and BOM handling of that decoder.
+
+require('../common');
+const assert = require('assert');
+
+const euro = [0xe2, 0x82, 0xac];
+const emoji = [0xf0, 0x9f, 0x98, 0x80];
+
+// ASCII input, including views into larger buffers.
+{
+  const decoder = new TextDecoder();
+  assert.strictEqual(decoder.decode(Buffer.from('hello world')),
+                     'hello world');
+  const ab = new ArrayBuffer(16);
+  new Uint8Array(ab).set(Buffer.from('0123456789abcdef'));
+  assert.strictEqual(decoder.decode(new DataView(ab, 2, 5)), '23456');
+  assert.strictEqual(decoder.decode(ab), '0123456789abcdef');
+  assert.strictEqual(decoder.decode(), '');
+}
+
+// Multi-byte sequences split at every possible position.
+{
+  const bytes = [0x61, ...euro, 0x62, ...emoji, 0x63];
+  for (let i = 0; i <= bytes.length; i++) {
+    for (let j = i; j <= bytes.length; j++) {
+      const decoder = new TextDecoder();
+      const result =
+        decoder.decode(new Uint8Array(bytes.slice(0, i)), { stream: true }) +
+        decoder.decode(new Uint8Array(bytes.slice(i, j)), { stream: true }) +
+        decoder.decode(new Uint8Array(bytes.slice(j)));
+      assert.strictEqual(result, 'a€b😀c');
+    }
+  }
+}
+
+// Replacement follows the maximal subpart rule of the Encoding Standard.
+{
+  const decoder = new TextDecoder();
+  const cases = [
+    [[0xff], '�'],
+    [[0xc0, 0x80], '��'],
+    [[0xe0, 0x80, 0x80], '���'],
+    [[0xed, 0xa0, 0x80], '���'],
+    [[0xf4, 0x90, 0x80, 0x80], '����'],
+    [[0xe2, 0x82, 0x41], '�A'],
+    [[0xf0, 0x9f, 0x98], '�'],
+    [[0x41, 0xe2], 'A�'],
+  ];
+  for (const [bytes, expected] of cases)
+    assert.strictEqual(decoder.decode(new Uint8Array(bytes)), expected);
+
+  // An unfinished sequence is only replaced when the stream ends.
+  assert.strictEqual(decoder.decode(new Uint8Array([0xe2, 0x82]),
+                                    { stream: true }), '');
+  assert.strictEqual(decoder.decode(), '�');
+}
+
+// Fatal mode throws and leaves the decoder usable.
+{
+  const decoder = new TextDecoder('utf-8', { fatal: true });
+  assert.throws(() => decoder.decode(new Uint8Array([0x61, 0xff])), {
+    code: 'ERR_ENCODING_INVALID_ENCODED_DATA',
+    name: 'TypeError',
+    message: 'The encoded data was not valid for encoding utf-8'
+  });
+  decoder.decode(new Uint8Array([0xe2]), { stream: true });
+  assert.throws(() => decoder.decode(), {
+    code: 'ERR_ENCODING_INVALID_ENCODED_DATA'
+  });
+  assert.strictEqual(decoder.decode(new Uint8Array(euro)), '€');
+}
+
+// A leading BOM is removed once per stream, even when it is split.
+{
+  const decoder = new TextDecoder();
+  const bom = [0xef, 0xbb, 0xbf];
+  assert.strictEqual(decoder.decode(new Uint8Array([...bom, ...bom, 0x61])),
+                     '﻿a');
+  assert.strictEqual(decoder.decode(new Uint8Array([0xef, 0xbb]),
+                                    { stream: true }), '');
+  assert.strictEqual(decoder.decode(new Uint8Array([0xbf, 0x61]),
+                                    { stream: true }), 'a');
+  assert.strictEqual(decoder.decode(new Uint8Array(bom)), '﻿');
+
+  const keepBOM = new TextDecoder('utf-8', { ignoreBOM: true });
+  assert.strictEqual(keepBOM.decode(new Uint8Array([...bom, 0x61])),
+                     '﻿a');
+}
@@ -70,8 +70,10 @@ if (common.hasIntl) {
     dec.decode(buf.slice(8));
   });
 } else {
+  // UTF-8 has its own decoder, so only other encodings need ICU for this.
+  assert.strictEqual(new TextDecoder('utf-8', { fatal: true }).fatal, true);
   assert.throws(
-    () => new TextDecoder('utf-8', { fatal: true }),
+    () => new TextDecoder('utf-16le', { fatal: true }),
     {
       code: 'ERR_NO_ICU',
       name: 'TypeError',
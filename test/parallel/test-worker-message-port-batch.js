@@ -0,0 +1,41 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel, receiveMessageOnPort } = require('worker_threads');
+
+// Messages are taken out of the shared queue in batches. Make sure that
+// ordering is preserved when the receiving side stops, resumes, or
+// synchronously receives messages in the middle of such a batch.
+
+const { port1, port2 } = new MessageChannel();
+const kCount = 5000;
+
+for (let i = 0; i < kCount; i++)
+  port1.postMessage(i);
+
+let expected = 0;
+const onmessage = common.mustCall((value) => {
+  assert.strictEqual(value, expected++);
+
+  if (value === 10) {
+    // Synchronous receives must continue where the batch left off.
+    assert.deepStrictEqual(receiveMessageOnPort(port2), { message: 11 });
+    assert.deepStrictEqual(receiveMessageOnPort(port2), { message: 12 });
+    expected = 13;
+  } else if (value === 100) {
+    // Removing the last listener stops the port in the middle of a batch.
+    port2.off('message', onmessage);
+    setImmediate(() => {
+      // Messages posted while stopped are queued behind the current batch.
+      port1.postMessage(kCount);
+      port2.on('message', onmessage);
+    });
+  } else if (value === kCount) {
+    port1.close();
+  }
+}, kCount + 1 - 2);
+port2.on('message', onmessage);
+
+port2.on('close', common.mustCall(() => {
+  assert.strictEqual(expected, kCount + 1);
+}));
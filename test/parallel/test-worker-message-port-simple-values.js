@@ -0,0 +1,147 @@
+'use strict';
+
+// Flags: --harmony-weak-refs
+
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel, receiveMessageOnPort } = require('worker_threads');
+
+// Primitive values and strings, and flat plain objects that only contain
+// them, take a shortcut around the ValueSerializer when they are posted
+// without a transfer list. Make sure that they arrive intact.
+
+const values = [
+  undefined,
+  null,
+  true,
+  false,
+  0,
+  -0,
+  1,
+  -1.5,
+  2 ** 53,
+  NaN,
+  Infinity,
+  -Infinity,
+  '',
+  'hello world',
+  'ÿ\u0000latin1',
+  '€ two-byte',
+  '😀 surrogate pair',
+  '\ud800 lone surrogate \udc00',
+  'x'.repeat(1 << 20),
+  '€'.repeat(1 << 20),
+];
+
+{
+  const { port1, port2 } = new MessageChannel();
+  for (const value of values) {
+    port1.postMessage(value);
+    const { message } = receiveMessageOnPort(port2);
+    assert(Object.is(message, value), `${message} !== ${value}`);
+  }
+
+  // Wrapper objects and values with a transfer list still go through the
+  // regular serializer.
+  port1.postMessage(Object('str'));
+  assert.deepStrictEqual(receiveMessageOnPort(port2).message, Object('str'));
+  port1.postMessage('str', []);
+  assert.strictEqual(receiveMessageOnPort(port2).message, 'str');
+  const { buffer } = new Uint8Array(4);
+  port1.postMessage('str', [buffer]);
+  assert.strictEqual(receiveMessageOnPort(port2).message, 'str');
+  assert.strictEqual(buffer.byteLength, 0);
+
+  assert.throws(() => port1.postMessage(Symbol('foo')), {
+    name: 'DataCloneError'
+  });
+
+  port1.close();
+}
+
+{
+  const { port1, port2 } = new MessageChannel();
+  const objects = [
+    {},
+    { action: 'pewpewpew', powerLevel: 9001 },
+    { a: undefined, b: null, c: true, d: false, e: -0, f: NaN },
+    { 'a': '€', '€': 'a', 'ab€': 'x€', '': '' },
+    { 2: 'two', 1: 'one', b: 'b', a: 'a' },
+    { 'x': 'y'.repeat(1 << 16), '😀': '€'.repeat(3) },
+    // Values that are objects take the regular path.
+    { nested: { a: 1 }, list: [1, 2] },
+    { date: new Date(0) },
+  ];
+  for (const object of objects) {
+    port1.postMessage(object);
+    const { message } = receiveMessageOnPort(port2);
+    assert.deepStrictEqual(message, object);
+    assert.deepStrictEqual(Object.keys(message), Object.keys(object));
+    assert.strictEqual(Object.getPrototypeOf(message), Object.prototype);
+  }
+
+  // Non-enumerable and symbol-keyed properties are not copied, and class
+  // instances arrive as plain objects, as with the regular serializer.
+  const object = { a: 1, [Symbol('s')]: 2 };
+  Object.defineProperty(object, 'hidden', { value: 3, enumerable: false });
+  port1.postMessage(object);
+  assert.deepStrictEqual(receiveMessageOnPort(port2).message, { a: 1 });
+  class Foo { constructor() { this.a = 1; } }
+  port1.postMessage(new Foo());
+  const { message } = receiveMessageOnPort(port2);
+  assert.deepStrictEqual(message, { a: 1 });
+  assert.strictEqual(Object.getPrototypeOf(message), Object.prototype);
+
+  // Getters run exactly once, even though they make the object take the
+  // regular path.
+  const withGetter = {
+    a: 1,
+    get b() { return 'b'; }
+  };
+  const getter = Object.getOwnPropertyDescriptor(withGetter, 'b').get;
+  Object.defineProperty(withGetter, 'b', {
+    get: common.mustCall(getter),
+    enumerable: true
+  });
+  port1.postMessage(withGetter);
+  assert.deepStrictEqual(receiveMessageOnPort(port2).message,
+                         { a: 1, b: 'b' });
+
+  // Objects without a prototype arrive as plain objects, too.
+  port1.postMessage(Object.assign(Object.create(null), { a: 1, b: 'b' }));
+  const { message: nullProto } = receiveMessageOnPort(port2);
+  assert.deepStrictEqual(nullProto, { a: 1, b: 'b' });
+
+  // Built-in objects are not plain objects, even if their prototype is
+  // replaced, and are still rejected by the regular serializer.
+  for (const value of [
+    new globalThis.WeakRef({}),
+    Object.setPrototypeOf(new globalThis.WeakRef({}), Object.prototype),
+    Object.setPrototypeOf(new globalThis.WeakRef({}), null),
+  ]) {
+    assert.throws(() => port1.postMessage(value), {
+      name: 'DataCloneError'
+    });
+  }
+
+  assert.throws(() => port1.postMessage({ a: Symbol('foo') }), {
+    name: 'DataCloneError'
+  });
+  assert.throws(() => port1.postMessage({ a: () => {} }), {
+    name: 'DataCloneError'
+  });
+
+  port1.close();
+}
+
+{
+  const { port1, port2 } = new MessageChannel();
+  let i = 0;
+  port2.on('message', common.mustCall((message) => {
+    assert(Object.is(message, values[i++]));
+    if (i === values.length)
+      port2.close();
+  }, values.length));
+  for (const value of values)
+    port1.postMessage(value);
+}
@@ -0,0 +1,141 @@
+'use strict';
+const common = require('../common');
+if (common.isWindows)
+  common.skip('socket handles cannot be transferred on Windows');
+
+const assert = require('assert');
+const net = require('net');
+const { MessageChannel, Worker } = require('worker_threads');
+
+// Test that socket and server handles can be transferred to Worker threads,
+// and that the objects that owned them on the sending side are cleaned up.
+
+const workerSource = `
+  const net = require('net');
+  const { parentPort } = require('worker_threads');
+  parentPort.on('message', ({ type, handle }) => {
+    if (type === 'socket') {
+      const socket = new net.Socket({ handle });
+      // Report what the receiving side sees, so that the main thread can
+      // check that this is the same connection.
+      parentPort.postMessage({
+        handleType: handle.constructor.name,
+        transferableHandle: socket.transferableHandle === handle,
+        localPort: socket.localPort,
+        remotePort: socket.remotePort,
+        readable: socket.readable,
+        writable: socket.writable
+      });
+      socket.on('data', (data) => socket.end(\`echo: \${data}\`));
+      socket.on('close', () => parentPort.close());
+    } else {
+      const server = net.createServer((socket) => {
+        socket.end('hello from the server');
+        server.close();
+        parentPort.close();
+      });
+      server.listen(handle, () => parentPort.postMessage('listening'));
+    }
+  });
+`;
+
+{
+  // Accept in this thread, serve in the Worker.
+  const worker = new Worker(workerSource, { eval: true });
+  const onConnection = common.mustCall((socket) => {
+    socket.on('close', common.mustCall(() => {
+      server.getConnections(common.mustCall((err, count) => {
+        assert.ifError(err);
+        assert.strictEqual(count, 0);
+        server.close(common.mustCall());
+      }));
+    }));
+    const { localPort, remotePort } = socket;
+    worker.once('message', common.mustCall((info) => {
+      assert.deepStrictEqual(info, {
+        handleType: 'TCP',
+        transferableHandle: true,
+        localPort,
+        remotePort,
+        readable: true,
+        writable: true
+      });
+    }));
+    const handle = socket.transferableHandle;
+    worker.postMessage({ type: 'socket', handle }, [ handle ]);
+  });
+  const server = net.createServer({ pauseOnConnect: true }, onConnection);
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    let response = '';
+    client.setEncoding('utf8');
+    client.on('data', (data) => response += data);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(response, 'echo: ping');
+    }));
+    client.write('ping');
+  }));
+  worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+}
+
+{
+  // Move a listening server to the Worker.
+  const worker = new Worker(workerSource, { eval: true });
+  const server = net.createServer(common.mustNotCall());
+  server.listen(0, common.mustCall(() => {
+    const { port } = server.address();
+    const handle = server.transferableHandle;
+    worker.postMessage({ type: 'server', handle }, [ handle ]);
+    server.on('close', common.mustCall(() => {
+      assert.strictEqual(server.listening, false);
+    }));
+
+    worker.once('message', common.mustCall(() => {
+      const client = net.connect(port);
+      let response = '';
+      client.setEncoding('utf8');
+      client.on('data', (data) => response += data);
+      client.on('end', common.mustCall(() => {
+        assert.strictEqual(response, 'hello from the server');
+      }));
+    }));
+  }));
+  worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+}
+
+{
+  // Sockets that are reading cannot be transferred, because data may already
+  // have been consumed on this side.
+  const server = net.createServer(common.mustCall((socket) => {
+    const { port1 } = new MessageChannel();
+    assert.throws(() => {
+      const handle = socket.transferableHandle;
+      port1.postMessage(handle, [ handle ]);
+    }, {
+      code: 'ERR_INVALID_TRANSFER_OBJECT'
+    });
+    port1.close();
+    socket.end();
+    server.close();
+  }));
+  server.listen(0, common.mustCall(() => {
+    net.connect(server.address().port).resume();
+  }));
+}
+
+{
+  // Handles must be listed in the transfer list.
+  const server = net.createServer();
+  assert.strictEqual(server.transferableHandle, null);
+  server.listen(0, common.mustCall(() => {
+    const { port1 } = new MessageChannel();
+    assert.throws(() => {
+      port1.postMessage(server.transferableHandle);
+    }, {
+      code: 'ERR_MISSING_MESSAGE_PORT_IN_TRANSFER_LIST'
+    });
+    port1.close();
+    server.close();
+  }));
+}
@@ -0,0 +1,35 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+// Workers that are deserialized from the built-in snapshot and workers that
+// set up their Context from scratch end up with the same environment.
+
+const code = `
+const { parentPort } = require('worker_threads');
+let cloneError;
+try {
+  parentPort.postMessage(() => {});
+} catch (err) {
+  cloneError = err.name;
+}
+parentPort.postMessage({
+  globals: Object.getOwnPropertyNames(globalThis).sort(),
+  cloneError
+});
+`;
+
+function run(execArgv) {
+  return new Promise((resolve, reject) => {
+    const worker = new Worker(code, { eval: true, execArgv });
+    worker.once('message', resolve);
+    worker.once('error', reject);
+  });
+}
+
+Promise.all([run([]), run(['--no-node-snapshot'])])
+  .then(common.mustCall(([fromSnapshot, fromScratch]) => {
+    assert.strictEqual(fromSnapshot.cloneError, 'DataCloneError');
+    assert.deepStrictEqual(fromSnapshot, fromScratch);
+  }));
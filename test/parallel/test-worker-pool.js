@@ -0,0 +1,143 @@
+'use strict';
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+const assert = require('assert');
+const { pathToFileURL } = require('url');
+const { Pool } = require('worker_threads');
+
+const filename = fixtures.path('worker-pool-tasks.js');
+
+assert.throws(() => new Pool('worker-pool-tasks.js'), {
+  code: 'ERR_WORKER_PATH'
+});
+assert.throws(() => new Pool(fixtures.path('x.txt')), {
+  code: 'ERR_WORKER_UNSUPPORTED_EXTENSION'
+});
+assert.throws(() => new Pool(filename, { maxThreads: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new Pool(filename, { minThreads: 2, maxThreads: 1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new Pool(filename, { maxQueue: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+
+// Tasks call the default export, or the export with the given name.
+(async () => {
+  const pool = new Pool(pathToFileURL(filename), { maxThreads: 2 });
+  assert.strictEqual(pool.threads, 0);
+
+  const results = await Promise.all([
+    pool.run(21),
+    pool.run({ a: [1, 2] }, { name: 'echo' }),
+    pool.run(5, { name: 'wait' }),
+  ]);
+  assert.deepStrictEqual(results, [42, { a: [1, 2] }, 5]);
+  assert.strictEqual(pool.threads, 2);
+
+  await assert.rejects(pool.run('boom', { name: 'fail' }), {
+    name: 'Error',
+    message: 'boom'
+  });
+  await assert.rejects(pool.run(0, { name: 'missing' }), {
+    name: 'TypeError',
+    message: 'Task function "missing" not found'
+  });
+  assert.throws(() => pool.run(0, { name: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+
+  // Objects in the transfer list are moved to the thread that runs the task.
+  const buffer = new ArrayBuffer(16);
+  assert.strictEqual(
+    await pool.run(buffer, { name: 'byteLength', transferList: [buffer] }),
+    16);
+  assert.strictEqual(buffer.byteLength, 0);
+
+  // A thread that exits during a task is replaced.
+  await assert.rejects(pool.run(1, { name: 'exit' }), {
+    code: 'ERR_WORKER_NOT_RUNNING'
+  });
+  assert.strictEqual(await pool.run(1), 2);
+
+  const stats = pool.stats;
+  assert.strictEqual(stats.completed, 5);
+  assert.strictEqual(stats.failed, 3);
+  assert(stats.runTime > 0);
+  assert(stats.waitTime >= 0);
+
+  // The `stats` option reports the run and wait time of a single task.
+  const result = await pool.run(10, { name: 'wait', stats: true });
+  assert.strictEqual(result.value, 10);
+  assert(result.runTime >= 0 && result.runTime <= pool.stats.runTime);
+  assert(result.waitTime >= 0);
+  assert.throws(() => pool.run(0, { stats: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+
+  await pool.destroy();
+  assert.strictEqual(pool.threads, 0);
+  await assert.rejects(pool.run(1), { code: 'ERR_WORKER_POOL_CLOSED' });
+})().then(common.mustCall());
+
+// Tasks are rejected once the queue is full, and 'drain' is emitted when
+// tasks are accepted again.
+(async () => {
+  const pool = new Pool(filename, { maxThreads: 1, maxQueue: 1 });
+  pool.on('drain', common.mustCall());
+
+  const running = pool.run(20, { name: 'wait' });
+  const queued = pool.run(1);
+  assert.strictEqual(pool.queueSize, 1);
+  await assert.rejects(pool.run(2), { code: 'ERR_WORKER_POOL_QUEUE_FULL' });
+
+  assert.strictEqual(await running, 20);
+  assert.strictEqual(await queued, 2);
+  assert.strictEqual(pool.queueSize, 0);
+
+  // destroy() rejects tasks that have not completed yet.
+  const rejected = [
+    pool.run(1000, { name: 'wait' }),
+    pool.run(1),
+  ].map((task) => assert.rejects(task, { code: 'ERR_WORKER_POOL_CLOSED' }));
+  await pool.destroy();
+  await Promise.all(rejected);
+})().then(common.mustCall());
+
+// Idle threads above `minThreads` are stopped after `idleTimeout`.
+(async () => {
+  const pool = new Pool(filename, {
+    minThreads: 1,
+    maxThreads: 3,
+    idleTimeout: 10
+  });
+  assert.strictEqual(pool.threads, 1);
+  const tasks = [1, 2, 3].map((ms) => pool.run(ms, { name: 'wait' }));
+  assert.strictEqual(pool.threads, 3);
+  await Promise.all(tasks);
+
+  const interval = setInterval(common.mustCallAtLeast(() => {
+    if (pool.threads > 1)
+      return;
+    clearInterval(interval);
+    pool.destroy();
+  }, 1), 10);
+})().then(common.mustCall());
+
+// A module that fails to load rejects each task, without stopping the thread.
+(async () => {
+  const pool = new Pool(fixtures.path('worker-pool-tasks-throw.js'), {
+    maxThreads: 1
+  });
+  pool.on('error', common.mustNotCall());
+  for (let i = 0; i < 3; i++) {
+    await assert.rejects(pool.run(i), {
+      name: 'Error',
+      message: 'Failed to load tasks'
+    });
+  }
+  assert.strictEqual(pool.threads, 1);
+  assert.strictEqual(pool.stats.failed, 3);
+  await pool.destroy();
+})().then(common.mustCall());
@@ -0,0 +1,76 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+// Test that the maxCpuTimeMs and maxEventLoopDelayMs resource limits are
+// enforced by the parent thread, and that the CPU time based
+// worker.performance.eventLoopUtilization() reports sensible values.
+
+{
+  const w = new Worker('while (true);', {
+    eval: true,
+    resourceLimits: { maxCpuTimeMs: 200 }
+  });
+  assert.strictEqual(w.resourceLimits.maxCpuTimeMs, 200);
+  assert.strictEqual(w.resourceLimits.maxEventLoopDelayMs, Infinity);
+  w.on('error', common.expectsError({
+    code: 'ERR_WORKER_CPU_LIMIT',
+    message: 'Worker terminated due to reaching CPU time limit: 200 ms'
+  }));
+  w.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 1);
+    const { active, utilization } = w.performance.eventLoopUtilization();
+    assert(active >= 200, `${active} < 200`);
+    assert(utilization > 0 && utilization <= 1);
+  }));
+}
+
+{
+  // The event loop is only blocked once the timer fires, so startup time is
+  // not counted against the limit.
+  const w = new Worker(`
+    require('worker_threads').parentPort.postMessage('ready');
+    setTimeout(() => { while (true); }, 10);
+  `, {
+    eval: true,
+    resourceLimits: { maxEventLoopDelayMs: 100 }
+  });
+  w.on('message', common.mustCall());
+  w.on('error', common.expectsError({
+    code: 'ERR_WORKER_EVENT_LOOP_BLOCKED',
+    message: 'Worker terminated because its event loop was blocked ' +
+             'for more than 100 ms'
+  }));
+  w.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 1);
+  }));
+}
+
+{
+  // A Worker that keeps its event loop responsive is not terminated.
+  const w = new Worker(`
+    let n = 0;
+    const interval = setInterval(() => {
+      if (++n === 20) clearInterval(interval);
+    }, 10);
+  `, {
+    eval: true,
+    resourceLimits: { maxEventLoopDelayMs: common.platformTimeout(1000) }
+  });
+  w.on('error', common.mustNotCall());
+  w.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    const elu1 = w.performance.eventLoopUtilization();
+    assert(elu1.idle > 0);
+    assert(elu1.active >= 0);
+    assert(elu1.utilization >= 0 && elu1.utilization <= 1);
+
+    // The values no longer change once the Worker has stopped.
+    const elu2 = w.performance.eventLoopUtilization(elu1);
+    assert.deepStrictEqual(elu2, { idle: 0, active: 0, utilization: 0 });
+    assert.deepStrictEqual(
+      w.performance.eventLoopUtilization(elu1, elu1),
+      { idle: 0, active: 0, utilization: 0 });
+  }));
+}
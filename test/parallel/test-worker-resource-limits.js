@@ -13,6 +13,8 @@ const testResourceLimits = {
   maxYoungGenerationSizeMb: 4,
   codeRangeSizeMb: 16,
   stackSizeMb: 1,
+  maxCpuTimeMs: Infinity,
+  maxEventLoopDelayMs: Infinity,
 };
 
 // Do not use isMainThread so that this test itself can be run inside a Worker.
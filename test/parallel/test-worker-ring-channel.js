@@ -0,0 +1,92 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker, createRingChannel } = require('worker_threads');
+
+// Test the basic behavior of a RingChannel on a single thread.
+{
+  const channel = createRingChannel({ size: 16 });
+  assert.strictEqual(channel.size, 16);
+  assert.strictEqual(channel.closed, false);
+  assert.strictEqual(channel.read(), null);
+  assert.strictEqual(channel.readSync(10), null);
+
+  // One 4-byte slot is reserved, and each record has a 4-byte header.
+  assert.strictEqual(channel.write('abcd'), true);
+  assert.strictEqual(channel.write(''), true);
+  assert.strictEqual(channel.write(''), false);
+  assert.strictEqual(channel.writeSync('', 10), false);
+  assert.deepStrictEqual(channel.read(), Buffer.from('abcd'));
+  assert.deepStrictEqual(channel.read(), Buffer.alloc(0));
+
+  // Payloads that wrap around the end of the ring are read back in one piece.
+  for (const data of ['ab', '', Buffer.from('abcdefgh'), '', 'ijklmnop']) {
+    assert.strictEqual(channel.write(data), true);
+    assert.deepStrictEqual(channel.read(), Buffer.from(data));
+  }
+  assert.strictEqual(channel.write(new Uint16Array([0x4241])), true);
+  assert.deepStrictEqual(channel.read(), Buffer.from('AB'));
+
+  assert.throws(() => channel.write(Buffer.alloc(9)), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => channel.write({}), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+
+  assert.strictEqual(channel.write('last'), true);
+  channel.close();
+  assert.strictEqual(channel.closed, true);
+  assert.strictEqual(channel.write('more'), false);
+  assert.deepStrictEqual(channel.readSync(), Buffer.from('last'));
+  assert.strictEqual(channel.readSync(), null);
+}
+
+[null, 'foo', { size: 8 }, { size: 16.5 }, { size: 2 ** 31 }].forEach((arg) => {
+  assert.throws(() => createRingChannel(arg), {
+    code: /^(ERR_INVALID_ARG_TYPE|ERR_OUT_OF_RANGE)$/
+  });
+});
+
+// Records pass between threads in order, in both directions, with the worker
+// blocking on readSync()/writeSync() and the main thread reading
+// asynchronously.
+{
+  const kCount = 10000;
+  const toWorker = createRingChannel({ size: 256 });
+  const fromWorker = createRingChannel({ size: 512 });
+  const worker = new Worker(`
+    const assert = require('assert');
+    const { workerData: { toWorker, fromWorker } } = require('worker_threads');
+    let record;
+    let i = 0;
+    while ((record = toWorker.readSync()) !== null) {
+      assert.strictEqual(record.readUInt32LE(0), i++);
+      assert(fromWorker.writeSync(record));
+    }
+    fromWorker.close();
+  `, { eval: true, workerData: { toWorker, fromWorker } });
+  worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+
+  (async () => {
+    let sent = 0;
+    let received = 0;
+    const reader = (async () => {
+      for await (const record of fromWorker) {
+        assert.strictEqual(record.length, 4 + received % 37);
+        assert.strictEqual(record.readUInt32LE(0), received++);
+      }
+    })();
+    while (sent < kCount) {
+      const record = Buffer.alloc(4 + sent % 37);
+      record.writeUInt32LE(sent);
+      if (toWorker.write(record))
+        sent++;
+      else
+        await new Promise(setImmediate);
+    }
+    toWorker.close();
+    await reader;
+    assert.strictEqual(received, kCount);
+  })().then(common.mustCall());
+}
@@ -0,0 +1,81 @@
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// Reference values computed with the zlib C library.
+const tests = [
+  ['', 0, 1],
+  ['hello', 907060870, 103547413],
+  ['helloworld', 4192936109, 389415997],
+  ['The quick brown fox jumps over the lazy dog', 1095738169, 1541148634],
+];
+
+for (const [input, crc, adler] of tests) {
+  assert.strictEqual(zlib.crc32(input), crc);
+  assert.strictEqual(zlib.crc32(Buffer.from(input)), crc);
+  assert.strictEqual(zlib.adler32(input), adler);
+  assert.strictEqual(zlib.adler32(Buffer.from(input)), adler);
+}
+
+// Strings are encoded as UTF-8.
+assert.strictEqual(zlib.crc32('€'), zlib.crc32(Buffer.from('€', 'utf8')));
+
+// Incremental computation.
+assert.strictEqual(zlib.crc32('world', zlib.crc32('hello')), 4192936109);
+assert.strictEqual(zlib.adler32('world', zlib.adler32('hello')), 389415997);
+
+// Other ArrayBufferViews, including ones that do not start at the
+// beginning of their buffer.
+{
+  const buf = Buffer.from('xxhelloxx');
+  const view = new DataView(buf.buffer, buf.byteOffset + 2, 5);
+  assert.strictEqual(zlib.crc32(view), 907060870);
+  assert.strictEqual(zlib.crc32(new Uint16Array([0x6568, 0x6c6c])),
+                     zlib.crc32('hell'));
+}
+
+// Inputs long enough for the SIMD implementations, with lengths that are
+// not multiples of their block sizes, must agree with a bytewise
+// computation.
+{
+  const data = Buffer.alloc(4099);
+  for (let i = 0; i < data.length; i++)
+    data[i] = (i * 31 + 7) & 0xff;
+  let crc = 0;
+  let adler = 1;
+  for (let i = 0; i < data.length; i++) {
+    crc = zlib.crc32(data.subarray(i, i + 1), crc);
+    adler = zlib.adler32(data.subarray(i, i + 1), adler);
+  }
+  assert.strictEqual(zlib.crc32(data), crc);
+  assert.strictEqual(zlib.adler32(data), adler);
+}
+
+// The gzip trailer contains the CRC32 of the uncompressed data.
+{
+  const input = Buffer.from('checksum me '.repeat(100));
+  const gzipped = zlib.gzipSync(input);
+  assert.strictEqual(gzipped.readUInt32LE(gzipped.length - 8),
+                     zlib.crc32(input));
+}
+
+for (const method of ['crc32', 'adler32']) {
+  [undefined, null, 1, {}, [1, 2]].forEach((data) => {
+    assert.throws(() => zlib[method](data), {
+      code: 'ERR_INVALID_ARG_TYPE',
+      name: 'TypeError'
+    });
+  });
+  assert.throws(() => zlib[method]('', '1'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError'
+  });
+  [-1, 2 ** 32, 1.5].forEach((initial) => {
+    assert.throws(() => zlib[method]('', initial), {
+      code: 'ERR_OUT_OF_RANGE',
+      name: 'RangeError'
+    });
+  });
+}
@@ -0,0 +1,110 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// The compression convenience methods produce their output in a single
+// native step. Make sure the result matches what the streams produce.
+
+const input = Buffer.from(JSON.stringify(
+  Array.from({ length: 2000 }, (_, i) => ({ id: i, name: `item ${i}` }))));
+
+function streamCompress(ctor, opts, cb) {
+  const chunks = [];
+  const stream = new ctor(opts);
+  stream.on('data', (chunk) => chunks.push(chunk));
+  stream.on('end', common.mustCall(() => cb(Buffer.concat(chunks))));
+  stream.end(input);
+}
+
+for (const [method, ctor, decompress] of [
+  ['deflate', zlib.Deflate, zlib.inflateSync],
+  ['gzip', zlib.Gzip, zlib.gunzipSync],
+  ['deflateRaw', zlib.DeflateRaw, zlib.inflateRawSync],
+  ['brotliCompress', zlib.BrotliCompress, zlib.brotliDecompressSync],
+]) {
+  const sync = zlib[`${method}Sync`];
+  for (const opts of [undefined, { level: 1 }, { chunkSize: 64 }]) {
+    const result = sync(input, opts);
+    assert.deepStrictEqual(decompress(result), input);
+    streamCompress(ctor, opts, (expected) => {
+      assert.deepStrictEqual(result, expected);
+    });
+    zlib[method](input, opts, common.mustCall((err, asyncResult) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(asyncResult, result);
+    }));
+  }
+
+  // Strings, ArrayBuffers and other views are accepted.
+  for (const data of [
+    input.toString('latin1'),
+    new Uint8Array(input).buffer,
+    new Float64Array(new Uint8Array(input).buffer, 8, 100),
+  ]) {
+    let expected;
+    if (typeof data === 'string')
+      expected = Buffer.from(data);
+    else if (data instanceof ArrayBuffer)
+      expected = Buffer.from(data);
+    else
+      expected = Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+    assert.deepStrictEqual(decompress(sync(data)), expected);
+  }
+
+  // Empty inputs.
+  assert.strictEqual(decompress(sync(Buffer.alloc(0))).length, 0);
+
+  // The output limit applies to the compressed size.
+  assert.throws(() => sync(input, { maxOutputLength: 16 }), {
+    code: 'ERR_BUFFER_TOO_LARGE',
+    name: 'RangeError'
+  });
+  zlib[method](input, { maxOutputLength: 16 }, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+  }));
+
+  // The output buffer is capped by the limit rather than by the worst-case
+  // bound of the compressor, and grows until it is reached.
+  {
+    const { length } = sync(input);
+    assert.deepStrictEqual(sync(input, { maxOutputLength: length }),
+                           sync(input));
+    assert.throws(() => sync(input, { maxOutputLength: length - 1 }), {
+      code: 'ERR_BUFFER_TOO_LARGE'
+    });
+    zlib[method](input, { maxOutputLength: length },
+                 common.mustCall((err, result) => {
+                   assert.ifError(err);
+                   assert.strictEqual(result.length, length);
+                 }));
+    zlib[method](input, { maxOutputLength: length - 1 },
+                 common.mustCall((err) => {
+                   assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+                 }));
+  }
+
+  // Invalid options are still rejected.
+  assert.throws(() => sync(input, { chunkSize: 1 }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+
+{
+  const dictionary = Buffer.from('{"id":,"name":"item "}');
+  const result = zlib.deflateSync(input, { dictionary });
+  assert.deepStrictEqual(zlib.inflateSync(result, { dictionary }), input);
+}
+
+{
+  const params = {
+    [zlib.constants.BROTLI_PARAM_MODE]: zlib.constants.BROTLI_MODE_TEXT,
+    [zlib.constants.BROTLI_PARAM_QUALITY]: 4,
+    [zlib.constants.BROTLI_PARAM_SIZE_HINT]: input.length
+  };
+  const result = zlib.brotliCompressSync(input, { params });
+  assert.deepStrictEqual(zlib.brotliDecompressSync(result), input);
+  assert.throws(() => zlib.brotliCompressSync(input, { params: { 1000: 1 } }), {
+    code: 'ERR_BROTLI_INVALID_PARAM'
+  });
+}
@@ -0,0 +1,100 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// Inputs that are larger than a single block are compressed in parallel and
+// must still produce a single standard stream that round-trips.
+
+const blockSize = 32 * 1024;
+const input = Buffer.alloc(blockSize * 5 + 123);
+for (let i = 0; i < input.length; i++)
+  input[i] = (i % 251) ^ ((i >> 12) & 0xff);
+
+for (const [method, decompress] of [
+  ['gzip', 'gunzipSync'],
+  ['deflate', 'inflateSync'],
+  ['deflateRaw', 'inflateRawSync'],
+]) {
+  for (const options of [
+    { parallel: 4, blockSize },
+    { parallel: 2, blockSize, level: 9, windowBits: 12 },
+    { parallel: 3, blockSize, level: 0 },
+    { parallel: 2, blockSize, strategy: zlib.constants.Z_HUFFMAN_ONLY },
+  ]) {
+    zlib[method](input, options, common.mustCall((err, result) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(zlib[decompress](result, options), input);
+    }));
+  }
+}
+
+// A gzip header identical to the sequential one is written.
+zlib.gzip(input, { parallel: 4, blockSize }, common.mustCall((err, result) => {
+  assert.ifError(err);
+  const sequential = zlib.gzipSync(input);
+  assert.deepStrictEqual(result.slice(0, 10), sequential.slice(0, 10));
+  assert.deepStrictEqual(result.slice(-8), sequential.slice(-8));
+}));
+
+// Strings, ArrayBuffers and TypedArrays are accepted.
+zlib.gzip(input.toString('latin1'), { parallel: 2, blockSize },
+          common.mustCall((err, result) => {
+            assert.ifError(err);
+            assert.strictEqual(zlib.gunzipSync(result).toString('latin1'),
+                               input.toString('latin1'));
+          }));
+{
+  const ab = new Uint8Array(input).buffer;
+  zlib.gzip(ab, { parallel: 2, blockSize }, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(zlib.gunzipSync(result), input);
+  }));
+  const view = new Uint16Array(ab, 2, 40000);
+  zlib.deflate(view, { parallel: 2, blockSize },
+               common.mustCall((err, result) => {
+                 assert.ifError(err);
+                 assert.deepStrictEqual(
+                   zlib.inflateSync(result),
+                   Buffer.from(ab, 2, 80000));
+               }));
+}
+
+// Inputs that fit into a single block, and options that are not supported by
+// the parallel mode, fall back to the sequential implementation.
+zlib.gzip('hello', { parallel: 4 }, common.mustCall((err, result) => {
+  assert.ifError(err);
+  assert.strictEqual(zlib.gunzipSync(result).toString(), 'hello');
+}));
+zlib.gzip(input, { parallel: 4, blockSize, info: true },
+          common.mustCall((err, result) => {
+            assert.ifError(err);
+            assert(result.engine instanceof zlib.Gzip);
+            assert.deepStrictEqual(zlib.gunzipSync(result.buffer), input);
+          }));
+
+zlib.gzip(input, { parallel: 4, blockSize, maxOutputLength: 64 },
+          common.mustCall((err) => {
+            assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+          }));
+
+// `parallel` is capped at the size of the threadpool.
+zlib.gzip(input, { parallel: 1024, blockSize },
+          common.mustCall((err, result) => {
+            assert.ifError(err);
+            assert.deepStrictEqual(zlib.gunzipSync(result), input);
+          }));
+
+for (const parallel of [0, 1025, Infinity]) {
+  assert.throws(() => zlib.gzip(input, { parallel }, common.mustNotCall()), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+assert.throws(() => zlib.gzip(input, { parallel: 2, blockSize: 1024 },
+                              common.mustNotCall()), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => zlib.gzip(input, { parallel: '2' },
+                              common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
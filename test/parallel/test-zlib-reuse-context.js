@@ -0,0 +1,77 @@
+'use strict';
+// Streams created with `reuseContext: true` share their underlying zlib
+// streams through a pool. Make sure that a reused stream behaves exactly
+// like a fresh one.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = Buffer.from('hello world, hello zlib! '.repeat(200));
+const dictionary = Buffer.from('hello world, hello zlib!');
+
+assert.throws(() => zlib.createGzip({ reuseContext: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  name: 'TypeError'
+});
+
+function roundTrip(i) {
+  if (i === 20) return;
+  const withDictionary = i % 2 === 1;
+  const opts = { reuseContext: true, level: i % 3 === 0 ? 9 : 1 };
+  if (withDictionary)
+    opts.dictionary = dictionary;
+
+  const expected = zlib.deflateSync(input, { ...opts, reuseContext: false });
+  const deflate = zlib.createDeflate(opts);
+  const chunks = [];
+  deflate.on('data', (chunk) => chunks.push(chunk));
+  deflate.on('end', common.mustCall(() => {
+    const compressed = Buffer.concat(chunks);
+    assert.deepStrictEqual(compressed, expected);
+    zlib.inflate(compressed, opts, common.mustCall((err, result) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(result, input);
+      // Give the closed streams a chance to be returned to the pool.
+      setImmediate(roundTrip, i + 1);
+    }));
+  }));
+  deflate.end(input);
+}
+
+roundTrip(0);
+
+// A stream that failed must not affect later streams.
+zlib.gunzip(Buffer.from('not gzip data'), { reuseContext: true },
+            common.mustCall((err) => {
+              assert.strictEqual(err.code, 'Z_DATA_ERROR');
+              const compressed = zlib.gzipSync(input);
+              zlib.gunzip(compressed, { reuseContext: true },
+                          common.mustCall((err, result) => {
+                            assert.ifError(err);
+                            assert.deepStrictEqual(result, input);
+                          }));
+            }));
+
+// Unzip auto-detects the format, which must be forgotten on reuse.
+{
+  const gzipped = zlib.gzipSync(input);
+  const deflated = zlib.deflateSync(input);
+  for (const compressed of [gzipped, deflated, gzipped, deflated]) {
+    const result = zlib.unzipSync(compressed, { reuseContext: true });
+    assert.deepStrictEqual(result, input);
+  }
+}
+
+// Parameters changed with params() are taken into account.
+{
+  const deflate = zlib.createDeflate({ reuseContext: true, level: 1 });
+  deflate.params(9, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+    deflate.end(input);
+    deflate.resume();
+    deflate.on('close', common.mustCall(() => {
+      const result = zlib.deflateSync(input, { reuseContext: true, level: 9 });
+      assert.deepStrictEqual(result, zlib.deflateSync(input, { level: 9 }));
+    }));
+  }));
+}
@@ -0,0 +1,93 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = Buffer.from('Hello, zstd! '.repeat(10000));
+
+// One-shot round trips, synchronous and asynchronous.
+{
+  const compressed = zlib.zstdCompressSync(input);
+  assert(compressed.length < input.length);
+  // Zstandard frame magic number.
+  assert.strictEqual(compressed.readUInt32LE(0), 0xFD2FB528);
+  assert.deepStrictEqual(zlib.zstdDecompressSync(compressed), input);
+
+  zlib.zstdCompress(input, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(result, compressed);
+    zlib.zstdDecompress(result, common.mustCall((err, result) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(result, input);
+    }));
+  }));
+}
+
+// Parameters, including negative compression levels.
+{
+  const { constants } = zlib;
+  for (const level of [-5, 1, 19]) {
+    const compressed = zlib.zstdCompressSync(input, {
+      params: {
+        [constants.ZSTD_c_compressionLevel]: level,
+        [constants.ZSTD_c_checksumFlag]: 1
+      }
+    });
+    assert.deepStrictEqual(zlib.zstdDecompressSync(compressed), input);
+  }
+
+  assert.throws(() => zlib.createZstdCompress({ params: { 1234: 1 } }), {
+    code: 'ERR_ZSTD_INVALID_PARAM',
+    name: 'RangeError'
+  });
+  // Decompression parameters are not valid for compression.
+  assert.throws(() => zlib.createZstdCompress({
+    params: { [constants.ZSTD_d_windowLogMax]: 20 }
+  }), {
+    code: 'ERR_ZSTD_INVALID_PARAM',
+    name: 'RangeError'
+  });
+  assert.throws(() => zlib.createZstdCompress({
+    params: { [constants.ZSTD_c_compressionLevel]: 'high' }
+  }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError'
+  });
+}
+
+// Streaming, with an explicit flush in the middle.
+{
+  const compress = zlib.createZstdCompress();
+  const decompress = zlib.createZstdDecompress();
+  compress.pipe(decompress);
+  const chunks = [];
+  decompress.on('data', (chunk) => chunks.push(chunk));
+  decompress.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), input);
+  }));
+
+  compress.write(input.slice(0, 1000));
+  compress.flush(common.mustCall(() => {
+    compress.end(input.slice(1000));
+  }));
+}
+
+// Concatenated frames decompress to the concatenated inputs.
+{
+  const a = zlib.zstdCompressSync('abc');
+  const b = zlib.zstdCompressSync('def');
+  assert.strictEqual(
+    zlib.zstdDecompressSync(Buffer.concat([a, b])).toString(), 'abcdef');
+}
+
+// Truncated and corrupt input.
+{
+  const compressed = zlib.zstdCompressSync(input);
+  assert.throws(
+    () => zlib.zstdDecompressSync(compressed.slice(0, compressed.length - 4)),
+    { code: 'Z_BUF_ERROR', message: 'unexpected end of file' });
+  zlib.zstdDecompress(Buffer.from('not zstd data'), common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ERR_ZSTD_DECOMPRESSION_FAILED');
+  }));
+}
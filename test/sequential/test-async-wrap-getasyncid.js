@@ -94,6 +94,14 @@ function testInitialized(req, ctor_name) {
 }
 
 
+{
+  const { AtomicsWaiter } = internalBinding('worker');
+  const waiter = new AtomicsWaiter();
+  testInitialized(waiter, 'AtomicsWaiter');
+  waiter.close();
+}
+
+
 {
   const FSEvent = internalBinding('fs_event_wrap').FSEvent;
   testInitialized(new FSEvent(), 'FSEvent');
@@ -166,8 +166,11 @@ const customTypesMap = {
   'vm.SourceTextModule': 'vm.html#vm_class_vm_sourcetextmodule',
 
   'MessagePort': 'worker_threads.html#worker_threads_class_messageport',
+  'Pool': 'worker_threads.html#worker_threads_class_pool',
+  'RingChannel': 'worker_threads.html#worker_threads_class_ringchannel',
 
   'zlib options': 'zlib.html#zlib_class_options',
+  'zstd options': 'zlib.html#zlib_class_zstdoptions',
 };
 
 const arrayPart = /(?:\[])+$/;